@@ -23,6 +23,9 @@ chBaseConfig = {
 vomsProxy = "x509up_u93032" # Does NOT work on condor node
 reduceJobsMCBy     = 5
 reduceJobsDataBy   = 10
+# Split jobs by balanced entry ranges (runMain -e auto) instead of whole files.
+# Fill config/SkimEntries.json locally before creating the tarball.
+splitJobsByEntries = False
 
 
 # Base configuration template remains the same.
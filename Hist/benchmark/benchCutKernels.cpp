@@ -0,0 +1,175 @@
+// Object preselection at per-event multiplicities: hand-written loop vs
+// survivor compaction per cut vs the CutKernels pass-mask sweeps for every
+// instruction set the CPU supports. Jet-like cuts: pt >= 15, |eta| < 1.3,
+// muonIdx1 == -1 (a float, an abs float and an int column).
+//
+// Build and run (from Hist/):
+//   make benchCutKernels
+//   ./benchCutKernels
+// Exits with 1 if any variant picks different indices than the loop.
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "CutKernels.h"
+
+namespace {
+
+constexpr std::size_t kCandidates = 1 << 22;  // per multiplicity, summed over events
+constexpr int kRepeat = 5;
+constexpr float kMinPt = 15.f;
+constexpr double kMaxEta = 1.3;
+
+struct Timer {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double ns() const {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+struct Columns {
+    std::vector<float> pt;
+    std::vector<float> eta;
+    std::vector<int> muonIdx;
+};
+
+auto makeColumns(std::size_t n) -> Columns {
+    std::mt19937 gen(42);
+    std::exponential_distribution<float> uPt(1.f / 20.f);
+    std::uniform_real_distribution<float> uEta(-4.7f, 4.7f);
+    std::uniform_int_distribution<int> uIdx(-1, 1);
+    Columns c{std::vector<float>(n), std::vector<float>(n), std::vector<int>(n)};
+    for (std::size_t i = 0; i < n; ++i) {
+        c.pt[i] = uPt(gen);
+        c.eta[i] = uEta(gen);
+        c.muonIdx[i] = uIdx(gen) < 0 ? -1 : uIdx(gen);
+    }
+    return c;
+}
+
+// The loops ObjectCuts replaced
+auto selectLoop(const Columns& c, std::size_t first, std::size_t n, int* idx) -> std::size_t {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j = first + i;
+        if (c.pt[j] < kMinPt) continue;
+        if (std::abs(c.eta[j]) >= kMaxEta) continue;
+        if (c.muonIdx[j] != -1) continue;
+        idx[k++] = static_cast<int>(i);
+    }
+    return k;
+}
+
+// One pass per cut over the survivors of the previous ones
+auto selectSurvivors(const Columns& c, std::size_t first, std::size_t n, int* idx) -> std::size_t {
+    const float* pt = &c.pt[first];
+    const float* eta = &c.eta[first];
+    const int* muonIdx = &c.muonIdx[first];
+    for (std::size_t i = 0; i < n; ++i) idx[i] = static_cast<int>(i);
+    std::size_t m = n;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+        idx[k] = idx[i];
+        k += static_cast<double>(pt[idx[i]]) >= kMinPt;
+    }
+    m = k;
+    k = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+        idx[k] = idx[i];
+        k += std::abs(static_cast<double>(eta[idx[i]])) < kMaxEta;
+    }
+    m = k;
+    k = 0;
+    for (std::size_t i = 0; i < m; ++i) {
+        idx[k] = idx[i];
+        k += muonIdx[idx[i]] == -1;
+    }
+    return k;
+}
+
+// As ObjectCuts::select
+auto selectMask(const Columns& c, std::size_t first, std::size_t n, std::uint8_t* mask, int* idx) -> std::size_t {
+    using CutKernels::Mode;
+    constexpr double inf = HUGE_VAL;
+    static const CutKernels::Test ptTest{Mode::Inside, false, kMinPt, inf};
+    static const CutKernels::Test etaTest{Mode::Inside, true, -inf, std::nextafter(kMaxEta, -inf)};
+    static const CutKernels::Test muonTest{Mode::Inside, false, -1.0, -1.0};
+    for (std::size_t i = 0; i < n; ++i) mask[i] = 1;
+    CutKernels::sweep(&c.pt[first], n, ptTest, mask);
+    if (CutKernels::count(mask, n) == 0) return 0;
+    CutKernels::sweep(&c.eta[first], n, etaTest, mask);
+    if (CutKernels::count(mask, n) == 0) return 0;
+    CutKernels::sweep(&c.muonIdx[first], n, muonTest, mask);
+    if (CutKernels::count(mask, n) == 0) return 0;
+    return CutKernels::compact(mask, n, idx);
+}
+
+// Runs select over all events of multiplicity n; ns per event of the best
+// repetition, and the picked indices of all events
+template <typename Select>
+auto run(std::size_t n, Select select, std::vector<int>& picked) -> double {
+    const std::size_t nEvents = kCandidates / n;
+    std::vector<int> idx(n);
+    double best = 0;
+    for (int r = 0; r < kRepeat; ++r) {
+        picked.clear();
+        Timer t;
+        for (std::size_t ev = 0; ev < nEvents; ++ev) {
+            const std::size_t k = select(ev * n, idx.data());
+            picked.insert(picked.end(), idx.begin(), idx.begin() + k);
+            picked.push_back(-1);
+        }
+        const double ns = t.ns() / nEvents;
+        if (r == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    constexpr CutKernels::Isa kIsas[] = {CutKernels::Isa::Scalar, CutKernels::Isa::Sse4, CutKernels::Isa::Avx2,
+                                         CutKernels::Isa::Avx512};
+    const Columns c = makeColumns(kCandidates);
+    std::vector<std::uint8_t> mask(128);
+    std::vector<int> reference, picked;
+    bool ok = true;
+
+    std::cout << "ns per event (object type with n candidates)" << '\n';
+    std::cout << std::setw(6) << "n" << std::setw(10) << "loop" << std::setw(11) << "survivors";
+    for (auto isa : kIsas) {
+        if (CutKernels::isSupported(isa)) std::cout << std::setw(10) << CutKernels::isaName(isa);
+    }
+    std::cout << '\n' << std::fixed << std::setprecision(1);
+
+    // Muons/electrons, photons, jets of a typical event, and a busy one
+    for (std::size_t n : {3, 4, 15, 32, 64, 128}) {
+        std::cout << std::setw(6) << n;
+        const double nsLoop = run(n, [&](std::size_t first, int* idx) { return selectLoop(c, first, n, idx); },
+                                  reference);
+        std::cout << std::setw(10) << nsLoop;
+        const double nsSurv = run(n, [&](std::size_t first, int* idx) { return selectSurvivors(c, first, n, idx); },
+                                  picked);
+        std::cout << std::setw(11) << nsSurv;
+        ok = ok && picked == reference;
+        for (auto isa : kIsas) {
+            if (!CutKernels::isSupported(isa)) continue;
+            CutKernels::setIsa(isa);
+            const double ns = run(n, [&](std::size_t first, int* idx) {
+                return selectMask(c, first, n, mask.data(), idx);
+            }, picked);
+            std::cout << std::setw(10) << ns;
+            if (picked != reference) {
+                std::cout << " (differs)";
+                ok = false;
+            }
+        }
+        std::cout << '\n';
+    }
+    std::cout << (ok ? "All variants pick the same candidates" : "MISMATCH between variants") << '\n';
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// Per-candidate vs batched e/gamma scale and smearing (EgmSsKernel):
+// bit-level comparison and timing on random candidates in event-sized blocks.
+//
+// Build and run (from Hist/):
+//   make benchEgmSs
+//   ./benchEgmSs                                          # electrons only
+//   ./benchEgmSs <photonSS.json> <scaleName> <smearName>  # also photons
+// e.g. ./benchEgmSs POG/EGM/S+SJSON/2022Re-recoBCD/photonSS.json \
+//          2022Re-recoBCD_ScaleJSON 2022Re-recoBCD_SmearingJSON
+// Exits with 1 if any batched value differs from the per-candidate one.
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "EgmSsKernel.h"
+
+namespace {
+
+constexpr std::size_t kBlock = 8;  // candidates per event
+constexpr std::size_t kN = 1 << 20;
+constexpr unsigned char kGains[3] = {1, 6, 12}; // Photon_seedGain
+
+struct Timer {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    double ns() const {
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+auto countDiffs(const std::vector<double>& a, const std::vector<double>& b) -> std::size_t {
+    std::size_t nDiff = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (std::memcmp(&a[i], &b[i], sizeof(double)) != 0) ++nDiff;
+    }
+    return nDiff;
+}
+
+void report(const char* what, double nsScalar, double nsBatch, std::size_t nDiff) {
+    std::cout << what << ": scalar " << nsScalar / kN << " ns, batch " << nsBatch / kN << " ns per candidate (x"
+              << nsScalar / nsBatch << "), " << nDiff << " of " << kN << " differ" << '\n';
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> uPt(5.f, 500.f), uEta(-2.5f, 2.5f), uR9(0.5f, 1.f);
+    std::uniform_real_distribution<float> uMass(0.f, 0.01f), uECorr(0.95f, 1.05f);
+    std::uniform_int_distribution<int> uGain(0, 2);
+    std::vector<float> pt(kN), eta(kN), mass(kN), eCorr(kN), r9(kN);
+    std::vector<unsigned char> gain(kN);
+    for (std::size_t i = 0; i < kN; ++i) {
+        pt[i] = uPt(gen);
+        eta[i] = uEta(gen);
+        mass[i] = uMass(gen);
+        eCorr[i] = uECorr(gen);
+        r9[i] = uR9(gen);
+        gain[i] = kGains[uGain(gen)];
+    }
+    std::vector<double> scalar(kN), batch(kN);
+    bool ok = true;
+
+    Timer tScalar;
+    for (std::size_t i = 0; i < kN; ++i) scalar[i] = EgmSsKernel::eleSsCorrection(pt[i], eta[i], mass[i], eCorr[i]);
+    const double nsScalar = tScalar.ns();
+    Timer tBatch;
+    for (std::size_t i = 0; i < kN; i += kBlock) {
+        EgmSsKernel::eleSsCorrections(kBlock, &pt[i], &eta[i], &mass[i], &eCorr[i], &batch[i]);
+    }
+    const double nsBatch = tBatch.ns();
+    std::size_t nDiff = countDiffs(scalar, batch);
+    report("Electron Ss", nsScalar, nsBatch, nDiff);
+    ok = ok && nDiff == 0;
+
+    if (argc == 4) {
+        auto cset = correction::CorrectionSet::from_file(argv[1]);
+        const auto scaleRef = cset->at(argv[2]);
+        const auto smearRef = cset->at(argv[3]);
+        const std::string nomOrSyst = "total_correction";
+        const unsigned int run = 356000;
+
+        // Same call as ScaleObject::getPhoScaleCorrection
+        Timer tScaleScalar;
+        for (std::size_t i = 0; i < kN; ++i) {
+            scalar[i] = scaleRef->evaluate({nomOrSyst, gain[i], static_cast<float>(run), eta[i], r9[i], pt[i]});
+        }
+        const double nsScaleScalar = tScaleScalar.ns();
+        Timer tScaleBatch;
+        for (std::size_t i = 0; i < kN; i += kBlock) {
+            EgmSsKernel::phoScaleCorrections(*scaleRef, nomOrSyst, run, kBlock, &gain[i], &eta[i], &r9[i], &pt[i],
+                                             &batch[i]);
+        }
+        const double nsScaleBatch = tScaleBatch.ns();
+        nDiff = countDiffs(scalar, batch);
+        report("Photon scale", nsScaleScalar, nsScaleBatch, nDiff);
+        ok = ok && nDiff == 0;
+
+        // Same call as ScaleObject::getPhoSmearCorrection
+        const std::string rho = "rho";
+        Timer tSmearScalar;
+        for (std::size_t i = 0; i < kN; ++i) scalar[i] = smearRef->evaluate({rho, eta[i], r9[i]});
+        const double nsSmearScalar = tSmearScalar.ns();
+        Timer tSmearBatch;
+        for (std::size_t i = 0; i < kN; i += kBlock) {
+            EgmSsKernel::phoSmearCorrections(*smearRef, rho, kBlock, &eta[i], &r9[i], &batch[i]);
+        }
+        const double nsSmearBatch = tSmearBatch.ns();
+        nDiff = countDiffs(scalar, batch);
+        report("Photon smear", nsSmearScalar, nsSmearBatch, nDiff);
+        ok = ok && nDiff == 0;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+// Per-jet JEC/JER chain of ScaleJetMet with the levels as a run-time mask
+// (flag check per jet and level) vs a compile-time mask (JetLevelChain),
+// for the chains the channels run: data (L1Rc, L2Rel, L2L3Res), MC with
+// and without JER. The correction factors are random, so this times the
+// per-jet pass of ScaleJetMet::sumJetsAndMet only, not the lookups.
+//
+// Build and run (from Hist/):
+//   make benchJetChain && ./benchJetChain
+// Exits with 1 if the two variants give different sums.
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "JetLevelChain.h"
+#include "P4.h"
+
+namespace {
+
+constexpr std::size_t kJets = 12;     // selected jets per event
+constexpr std::size_t kEvents = 200000;
+
+struct Events {
+    std::vector<float> pt, mass, eta, phi, rawScale;
+    std::vector<double> corr[JetLevelChain::nSteps];
+};
+
+// The per-jet pass of ScaleJetMet::sumJetsAndMet
+template <typename Advance>
+auto sumJets(const Events& ev, Advance advance) -> P4 {
+    P4 sum;
+    for (std::size_t e = 0; e < kEvents; ++e) {
+        const std::size_t first = e * kJets;
+        const double* const corr[JetLevelChain::nSteps] = {&ev.corr[0][first], &ev.corr[1][first],
+                                                           &ev.corr[2][first], &ev.corr[3][first]};
+        for (std::size_t k = 0; k < kJets; ++k) {
+            const std::size_t j = first + k;
+            const double cosPhi = std::cos(static_cast<double>(ev.phi[j]));
+            const double sinPhi = std::sin(static_cast<double>(ev.phi[j]));
+            const double sinhEta = std::sinh(static_cast<double>(ev.eta[j]));
+            float pt = ev.pt[j];
+            float mass = ev.mass[j];
+            sum += P4::fromPtM(pt, cosPhi, sinPhi, sinhEta, mass);
+            pt *= ev.rawScale[j];
+            mass *= ev.rawScale[j];
+            advance(pt, mass, corr, k);
+            sum -= P4::fromPtM(pt, cosPhi, sinPhi, sinhEta, mass);
+        }
+    }
+    return sum;
+}
+
+template <unsigned kMask>
+auto run(const char* name, const Events& ev) -> bool {
+    volatile unsigned maskIn = kMask; // keep the compiler from folding the run-time mask
+    const unsigned mask = maskIn;
+    auto t0 = std::chrono::steady_clock::now();
+    using Corr = const double* const (&)[JetLevelChain::nSteps];
+    const P4 sumRuntime = sumJets(ev, [mask](float& pt, float& mass, Corr corr, std::size_t k) {
+        JetLevelChain::advance(mask, pt, mass, corr, k);
+    });
+    auto t1 = std::chrono::steady_clock::now();
+    const P4 sumTyped = sumJets(ev, [](float& pt, float& mass, Corr corr, std::size_t k) {
+        JetLevelChain::advance<kMask>(pt, mass, corr, k);
+    });
+    auto t2 = std::chrono::steady_clock::now();
+    const double nsRuntime = std::chrono::duration<double, std::nano>(t1 - t0).count() / (kEvents * kJets);
+    const double nsTyped = std::chrono::duration<double, std::nano>(t2 - t1).count() / (kEvents * kJets);
+    const bool same = sumRuntime.px == sumTyped.px && sumRuntime.py == sumTyped.py &&
+                      sumRuntime.pz == sumTyped.pz && sumRuntime.e == sumTyped.e;
+    std::cout << name << ": run-time mask " << nsRuntime << " ns, compile-time mask " << nsTyped
+              << " ns per jet (x" << nsRuntime / nsTyped << ")" << (same ? "" : ", SUMS DIFFER") << '\n';
+    return same;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> uPt(15.f, 500.f), uEta(-5.f, 5.f), uPhi(-3.14159f, 3.14159f);
+    std::uniform_real_distribution<float> uMass(0.f, 20.f), uRaw(0.8f, 1.f);
+    std::uniform_real_distribution<double> uCorr(0.8, 1.3);
+    Events ev;
+    const std::size_t n = kEvents * kJets;
+    for (std::size_t j = 0; j < n; ++j) {
+        ev.pt.push_back(uPt(gen));
+        ev.mass.push_back(uMass(gen));
+        ev.eta.push_back(uEta(gen));
+        ev.phi.push_back(uPhi(gen));
+        ev.rawScale.push_back(uRaw(gen));
+        for (auto& corr : ev.corr) corr.push_back(uCorr(gen));
+    }
+    bool ok = true;
+    using namespace JetLevelChain;
+    ok = run<L1Rc | L2Rel | L2L3Res>("Data (L1Rc, L2Rel, L2L3Res)", ev) && ok;
+    ok = run<L1Rc | L2Rel | Jer>("MC (L1Rc, L2Rel, Jer)      ", ev) && ok;
+    ok = run<L1Rc | L2Rel>("MC (L1Rc, L2Rel)           ", ev) && ok;
+    return ok ? 0 : 1;
+}
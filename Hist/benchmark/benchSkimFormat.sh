@@ -0,0 +1,47 @@
+#!/bin/bash
+# Compare TTree and RNTuple skims of the same sample: file size on disk,
+# Hist read throughput (events/s) and peak memory (max RSS).
+#
+# Usage (from Hist/, runMain built with make RNTUPLE=1):
+#   ./benchmark/benchSkimFormat.sh <outName> <jsonDirTTree> <jsonDirRNTuple>
+# e.g.
+#   ./benchmark/benchSkimFormat.sh MC_ZmmJet_2018_DYJetsToLL_M-50_Hist_1of1.root \
+#       input/json/ input/jsonRNTuple/
+# Both json directories hold FilesSkim_<Channel>_<Year>.json with the same
+# sample key, one listing the Skim output of -f ttree and one of -f rntuple.
+# Only local (or fuse mounted /eos) files are counted for the size.
+
+if [ $# -ne 3 ]; then
+    sed -n '2,13p' "$0"
+    exit 1
+fi
+outName=$1
+sampKey=${outName%_Hist_*}
+channel=$(echo "$sampKey" | cut -d_ -f2)
+year=$(echo "$sampKey" | cut -d_ -f3)
+logDir=output/benchmark
+mkdir -p "$logDir"
+
+sumFileSize() {
+    python3 - "$1/FilesSkim_${channel}_${year}.json" "$sampKey" <<'PYEOF'
+import json, os, sys
+files = json.load(open(sys.argv[1]))[sys.argv[2]][1]
+size = sum(os.path.getsize(f) for f in files if os.path.exists(f))
+print(f"{size / 1024**2:.1f}")
+PYEOF
+}
+
+printf "%-8s %12s %10s %10s %14s %12s\n" "Format" "Size(MB)" "Events" "Wall(s)" "Events/s" "MaxRSS(MB)"
+for format in TTree RNTuple; do
+    if [ "$format" == "TTree" ]; then jsonDir=$2; else jsonDir=$3; fi
+    log="$logDir/${sampKey}_${format}.log"
+    /usr/bin/time -v ./runMain -i "$jsonDir" -o "$outName" > "$log" 2>&1
+    size=$(sumFileSize "$jsonDir")
+    events=$(grep "Total Entries:" "$log" | tail -1 | awk '{print $NF}')
+    wall=$(grep "Elapsed (wall clock)" "$log" | awk -F': ' '{print $2}' \
+           | awk -F: '{ if (NF == 3) print $1*3600 + $2*60 + $3; else print $1*60 + $2 }')
+    rss=$(grep "Maximum resident set size" "$log" | awk '{printf "%.1f", $NF / 1024}')
+    rate=$(awk -v n="$events" -v t="$wall" 'BEGIN { if (t > 0) printf "%.0f", n / t; else print "-" }')
+    printf "%-8s %12s %10s %10s %14s %12s\n" "$format" "$size" "$events" "$wall" "$rate" "$rss"
+done
+echo "Logs in $logDir, histograms of the last run in output/$outName"
@@ -35,6 +35,8 @@ def createJobs(jsonFile, jdlFile, logDir="log"):
             restStr = skim.split(sKey)[1]
             oName   = "%s%s"%(sKey, restStr)
             args =  'Arguments  = %s %s\n' %(oName, outDir)
+            if splitJobsByEntries:
+                args =  'Arguments  = %s %s auto\n' %(oName, outDir)
             args += "Queue 1\n"
             jdlFile.write(args)
     jdlFile.close() 
@@ -25,12 +25,18 @@ echo "All arguements: "$@
 echo "Number of arguements: "$#
 oName=$1
 outDir=$2
+entryRange=$3
 
 #for correctionlib
 export LD_LIBRARY_PATH=$(pwd):$LD_LIBRARY_PATH
 
-echo "./runMain -o oName"
-./runMain -o ${oName}
+if [ -z ${entryRange} ] ; then
+    echo "./runMain -o oName"
+    ./runMain -o ${oName}
+else
+    echo "./runMain -o oName -e entryRange"
+    ./runMain -o ${oName} -e ${entryRange}
+fi
 
 printf "Done histograming at ";/bin/date
 #---------------------------------------------
@@ -0,0 +1,208 @@
+#include "CorrectionCache.h"
+
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'J', 'E', 'R', 'C', 'B', 'L', 'O', 'B'};
+constexpr std::size_t kAlign = 64;
+constexpr std::size_t kNameSize = 112;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t nSections;
+    std::uint64_t payloadOffset; // from the start of the file
+    std::uint64_t payloadSize;
+    std::uint64_t checksum;      // of the bytes after the header
+    char padding[24];
+};
+static_assert(sizeof(Header) == 64, "CorrectionCache header must be 64 bytes");
+
+struct SectionEntry {
+    char name[kNameSize];
+    std::uint64_t offset; // from the start of the payload
+    std::uint64_t size;
+};
+static_assert(sizeof(SectionEntry) == 128, "CorrectionCache section entry must be 128 bytes");
+
+auto alignUp(std::size_t n) -> std::size_t { return (n + kAlign - 1) / kAlign * kAlign; }
+
+// "path size mtime" of a source file, empty if it does not exist
+auto describeSource(const std::string& path) -> std::string {
+    struct stat st {};
+    if (stat(path.c_str(), &st) != 0) return "";
+    std::ostringstream oss;
+    oss << path << ' ' << st.st_size << ' ' << st.st_mtime;
+    return oss.str();
+}
+
+} // namespace
+
+auto CorrectionCache::checksum(const unsigned char* data, std::size_t size) -> std::uint64_t {
+    // FNV-1a, 64 bit
+    std::uint64_t hash = 1469598103934665603ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+auto CorrectionCache::defaultPath(const std::string& yearStr, const std::string& eraStr) -> std::string {
+    return "cache/Corrections_" + yearStr + "_" + (eraStr.empty() ? std::string("MC") : eraStr) + ".bin";
+}
+
+auto CorrectionCache::open(const std::string& path) -> std::shared_ptr<const CorrectionCache> {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("CorrectionCache: cannot open " + path);
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("CorrectionCache: " + path + " is truncated");
+    }
+    const std::size_t fileSize = st.st_size;
+    void* map = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping stays valid
+    if (map == MAP_FAILED) {
+        throw std::runtime_error("CorrectionCache: mmap failed for " + path);
+    }
+
+    std::shared_ptr<CorrectionCache> cache(new CorrectionCache());
+    cache->path_ = path;
+    cache->map_ = map;
+    cache->mapSize_ = fileSize;
+
+    const auto* base = static_cast<const unsigned char*>(map);
+    Header header{};
+    std::memcpy(&header, base, sizeof(Header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("CorrectionCache: " + path + " is not a correction cache");
+    }
+    if (header.version != kVersion) {
+        throw std::runtime_error("CorrectionCache: " + path + " has version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(kVersion) + ". Rebuild it with runMain -C");
+    }
+    const std::size_t tableEnd = sizeof(Header) + header.nSections * sizeof(SectionEntry);
+    if (tableEnd > fileSize || header.payloadOffset + header.payloadSize > fileSize) {
+        throw std::runtime_error("CorrectionCache: " + path + " is truncated");
+    }
+    if (checksum(base + sizeof(Header), fileSize - sizeof(Header)) != header.checksum) {
+        throw std::runtime_error("CorrectionCache: checksum mismatch in " + path);
+    }
+
+    const unsigned char* payload = base + header.payloadOffset;
+    for (std::uint32_t i = 0; i < header.nSections; ++i) {
+        SectionEntry entry{};
+        std::memcpy(&entry, base + sizeof(Header) + i * sizeof(SectionEntry), sizeof(SectionEntry));
+        entry.name[kNameSize - 1] = '\0';
+        if (entry.offset + entry.size > header.payloadSize) {
+            throw std::runtime_error("CorrectionCache: section " + std::string(entry.name) + " out of range");
+        }
+        cache->sections_[entry.name] = {payload + entry.offset, static_cast<std::size_t>(entry.size)};
+    }
+    std::cout << "CorrectionCache: mapped " << path << " (" << header.nSections << " sections, "
+              << fileSize / 1024 << " kB)" << '\n';
+    return cache;
+}
+
+CorrectionCache::~CorrectionCache() {
+    if (map_) munmap(map_, mapSize_);
+}
+
+auto CorrectionCache::section(const std::string& name) const -> const std::pair<const unsigned char*, std::size_t>& {
+    auto it = sections_.find(name);
+    if (it == sections_.end()) {
+        throw std::runtime_error("CorrectionCache: no section " + name + " in " + path_);
+    }
+    return it->second;
+}
+
+auto CorrectionCache::isUpToDate() const -> bool {
+    if (!has("meta/sources")) return false;
+    std::istringstream lines(getText("meta/sources"));
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.empty()) continue;
+        const std::string path = line.substr(0, line.find(' '));
+        if (describeSource(path) != line) {
+            std::cout << "CorrectionCache: " << path << " changed since " << path_ << " was written" << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+void CorrectionCacheWriter::addBytes(const std::string& name, std::string bytes) {
+    if (name.size() >= kNameSize) {
+        throw std::runtime_error("CorrectionCacheWriter: section name too long: " + name);
+    }
+    sections_[name] = std::move(bytes);
+}
+
+void CorrectionCacheWriter::addSource(const std::string& path) {
+    const std::string source = describeSource(path);
+    if (source.empty()) {
+        throw std::runtime_error("CorrectionCacheWriter: source file " + path + " not found");
+    }
+    sources_.push_back(source);
+}
+
+void CorrectionCacheWriter::write(const std::string& path) const {
+    std::map<std::string, std::string> sections = sections_;
+    std::string sources;
+    for (const auto& source : sources_) sources += source + '\n';
+    sections["meta/sources"] = sources + '\0';
+
+    const std::size_t payloadOffset = alignUp(sizeof(Header) + sections.size() * sizeof(SectionEntry));
+    std::vector<SectionEntry> table;
+    std::size_t payloadSize = 0;
+    for (const auto& [name, bytes] : sections) {
+        SectionEntry entry{};
+        std::strncpy(entry.name, name.c_str(), kNameSize - 1);
+        entry.offset = payloadSize;
+        entry.size = bytes.size();
+        table.push_back(entry);
+        payloadSize = alignUp(payloadSize + bytes.size());
+    }
+
+    std::vector<unsigned char> file(payloadOffset + payloadSize, 0);
+    std::memcpy(file.data() + sizeof(Header), table.data(), table.size() * sizeof(SectionEntry));
+    std::size_t i = 0;
+    for (const auto& [name, bytes] : sections) {
+        std::memcpy(file.data() + payloadOffset + table[i++].offset, bytes.data(), bytes.size());
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = CorrectionCache::kVersion;
+    header.nSections = static_cast<std::uint32_t>(sections.size());
+    header.payloadOffset = payloadOffset;
+    header.payloadSize = payloadSize;
+    header.checksum = CorrectionCache::checksum(file.data() + sizeof(Header), file.size() - sizeof(Header));
+    std::memcpy(file.data(), &header, sizeof(Header));
+
+    const std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("CorrectionCacheWriter: cannot write " + tmpPath);
+    }
+    out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+    out.close();
+    if (!out || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("CorrectionCacheWriter: cannot write " + path);
+    }
+    std::cout << "CorrectionCacheWriter: wrote " << path << " (" << sections.size() << " sections, "
+              << file.size() / 1024 << " kB)" << '\n';
+}
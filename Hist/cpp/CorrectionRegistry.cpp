@@ -0,0 +1,131 @@
+#include "CorrectionRegistry.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace {
+
+// Seconds with two decimals, without leaving std::cout in fixed mode
+auto formatSeconds(double seconds) -> std::string {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2) << seconds;
+    return oss.str();
+}
+
+} // namespace
+
+auto CorrectionRegistry::getInstance() -> CorrectionRegistry& {
+    static CorrectionRegistry instance;
+    return instance;
+}
+
+auto CorrectionRegistry::get(const std::string& jsonPath) -> std::shared_ptr<const correction::CorrectionSet> {
+    auto it = sets_.find(jsonPath);
+    if (it == sets_.end()) {
+        const auto start = std::chrono::steady_clock::now();
+        Entry entry;
+        // Throws on a missing or malformed file; nothing is cached then
+        entry.set = correction::CorrectionSet::from_file(jsonPath);
+        entry.parseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "CorrectionRegistry: parsed " << jsonPath << " in "
+                  << formatSeconds(entry.parseSeconds) << " s" << '\n';
+        it = sets_.emplace(jsonPath, std::move(entry)).first;
+    }
+    ++it->second.nRequests;
+    return it->second.set;
+}
+
+auto CorrectionRegistry::getCorrection(const std::string& jsonPath, const std::string& name) -> correction::Correction::Ref {
+    return get(jsonPath)->at(name);
+}
+
+auto CorrectionRegistry::getCorrection(const CorrectionCache& cache, const std::string& name) -> correction::Correction::Ref {
+    return getCorrection(cache, "corr/" + name, name);
+}
+
+auto CorrectionRegistry::getCorrection(const CorrectionCache& cache, const std::string& section,
+                                       const std::string& name) -> correction::Correction::Ref {
+    const std::string key = cache.getPath() + "#" + section;
+    auto it = sets_.find(key);
+    if (it == sets_.end()) {
+        const auto start = std::chrono::steady_clock::now();
+        Entry entry;
+        entry.set = correction::CorrectionSet::from_string(cache.getText(section));
+        entry.parseSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        it = sets_.emplace(key, std::move(entry)).first;
+    }
+    ++it->second.nRequests;
+    return it->second.set->at(name);
+}
+
+auto CorrectionRegistry::getCorrectionJson(const std::string& jsonPath, const std::string& name) -> const nlohmann::json& {
+    auto it = rawCorrections_.find(jsonPath);
+    if (it == rawCorrections_.end()) {
+        // gzread also reads uncompressed files
+        gzFile file = gzopen(jsonPath.c_str(), "rb");
+        if (!file) {
+            throw std::runtime_error("Error: cannot open " + jsonPath + " in CorrectionRegistry");
+        }
+        std::string text;
+        char buffer[1 << 16];
+        int nRead = 0;
+        while ((nRead = gzread(file, buffer, sizeof(buffer))) > 0) {
+            text.append(buffer, nRead);
+        }
+        if (nRead < 0) {
+            int errnum = 0;
+            const std::string error = gzerror(file, &errnum);
+            gzclose(file);
+            throw std::runtime_error("Error: cannot read " + jsonPath + " in CorrectionRegistry: " + error);
+        }
+        gzclose(file);
+        const auto js = nlohmann::json::parse(text);
+        std::map<std::string, nlohmann::json> byName;
+        for (const auto& corr : js.at("corrections")) {
+            byName.emplace(corr.at("name").get<std::string>(), corr);
+        }
+        rawSchemaVersions_[jsonPath] = js.value("schema_version", 2);
+        it = rawCorrections_.emplace(jsonPath, std::move(byName)).first;
+    }
+    auto corr = it->second.find(name);
+    if (corr == it->second.end()) {
+        throw std::runtime_error("Error: no correction " + name + " in " + jsonPath);
+    }
+    return corr->second;
+}
+
+auto CorrectionRegistry::getStandaloneJson(const std::string& jsonPath, const std::string& name) -> std::string {
+    nlohmann::json set;
+    set["corrections"] = nlohmann::json::array({getCorrectionJson(jsonPath, name)});
+    set["schema_version"] = rawSchemaVersions_.at(jsonPath);
+    return set.dump();
+}
+
+void CorrectionRegistry::releaseRawJson() {
+    rawCorrections_.clear();
+    rawSchemaVersions_.clear();
+}
+
+auto CorrectionRegistry::getNRequests() const -> int {
+    int n = 0;
+    for (const auto& [path, entry] : sets_) n += entry.nRequests;
+    return n;
+}
+
+void CorrectionRegistry::printStats() const {
+    double totalSeconds = 0.0;
+    std::cout << std::left << std::setw(10) << "Requests" << std::setw(12) << "Parse(s)" << "File" << '\n';
+    for (const auto& [path, entry] : sets_) {
+        totalSeconds += entry.parseSeconds;
+        std::cout << std::left << std::setw(10) << entry.nRequests
+                  << std::setw(12) << formatSeconds(entry.parseSeconds)
+                  << path << '\n';
+    }
+    std::cout << std::right;
+    std::cout << "Parsed " << getNParsed() << " file(s) for " << getNRequests()
+              << " request(s) in " << formatSeconds(totalSeconds) << " s" << '\n';
+}
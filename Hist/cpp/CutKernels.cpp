@@ -0,0 +1,173 @@
+#include "CutKernels.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace CutKernels {
+namespace {
+
+// sweepScalar with the mode and abs fixed: simple enough for the
+// vectoriser, which widens the values to double, compares them and packs
+// the results into the mask bytes with the instructions of the target.
+template <Mode M, bool Abs, typename T>
+__attribute__((always_inline)) inline void sweepLoop(const T* __restrict col, std::size_t n, double lo, double hi,
+                                                     std::uint8_t* __restrict mask) {
+    for (std::size_t i = 0; i < n; ++i) {
+        double v = static_cast<double>(col[i]);
+        if (Abs) v = std::fabs(v);
+        bool pass = M == Mode::Outside ? (v <= lo) | (v >= hi) : (v >= lo) & (v <= hi);
+        if (M == Mode::NotInside) pass = !pass;
+        mask[i] &= static_cast<std::uint8_t>(pass);
+    }
+}
+
+// Mode and abs are chosen once per sweep, not per candidate
+template <typename T>
+__attribute__((always_inline)) inline void sweepModes(const T* col, std::size_t n, const Test& test,
+                                                      std::uint8_t* mask) {
+    switch (test.mode) {
+        case Mode::Inside:
+            return test.abs ? sweepLoop<Mode::Inside, true>(col, n, test.lo, test.hi, mask)
+                            : sweepLoop<Mode::Inside, false>(col, n, test.lo, test.hi, mask);
+        case Mode::NotInside:
+            return test.abs ? sweepLoop<Mode::NotInside, true>(col, n, test.lo, test.hi, mask)
+                            : sweepLoop<Mode::NotInside, false>(col, n, test.lo, test.hi, mask);
+        case Mode::Outside:
+            return test.abs ? sweepLoop<Mode::Outside, true>(col, n, test.lo, test.hi, mask)
+                            : sweepLoop<Mode::Outside, false>(col, n, test.lo, test.hi, mask);
+    }
+}
+
+__attribute__((always_inline)) inline auto countLoop(const std::uint8_t* mask, std::size_t n) -> std::size_t {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; ++i) k += mask[i];
+    return k;
+}
+
+// Baseline instruction set only
+template <typename T>
+void sweepScalarKernel(const T* col, std::size_t n, const Test& test, std::uint8_t* mask) {
+    sweepModes(col, n, test, mask);
+}
+
+auto countScalar(const std::uint8_t* mask, std::size_t n) -> std::size_t {
+    return countLoop(mask, n);
+}
+
+// The kernels of one instruction set; CutKernels.cpp is compiled with -O3
+// (Makefile) so that the vectoriser runs
+#define CUTKERNELS_ISA(Suffix, Target)                                                               \
+    template <typename T>                                                                            \
+    __attribute__((target(Target))) void sweep##Suffix(const T* col, std::size_t n, const Test& test, \
+                                                       std::uint8_t* mask) {                         \
+        sweepModes(col, n, test, mask);                                                              \
+    }                                                                                                \
+    __attribute__((target(Target))) auto count##Suffix(const std::uint8_t* mask, std::size_t n)      \
+        -> std::size_t {                                                                             \
+        return countLoop(mask, n);                                                                   \
+    }
+
+CUTKERNELS_ISA(Sse4, "sse4.2")
+CUTKERNELS_ISA(Avx2, "avx2")
+CUTKERNELS_ISA(Avx512, "avx512f,avx512bw,avx512vl")
+
+#undef CUTKERNELS_ISA
+
+template <typename T>
+using SweepFn = void (*)(const T*, std::size_t, const Test&, std::uint8_t*);
+
+struct Kernels {
+    Isa isa;
+    SweepFn<float> sweepFloat;
+    SweepFn<int> sweepInt;
+    SweepFn<double> sweepDouble;
+    std::size_t (*count)(const std::uint8_t* mask, std::size_t n);
+};
+
+auto kernelsFor(Isa isa) -> Kernels {
+    switch (isa) {
+        case Isa::Sse4: return {isa, &sweepSse4<float>, &sweepSse4<int>, &sweepSse4<double>, &countSse4};
+        case Isa::Avx2: return {isa, &sweepAvx2<float>, &sweepAvx2<int>, &sweepAvx2<double>, &countAvx2};
+        case Isa::Avx512:
+            return {isa, &sweepAvx512<float>, &sweepAvx512<int>, &sweepAvx512<double>, &countAvx512};
+        case Isa::Scalar: break;
+    }
+    return {Isa::Scalar, &sweepScalarKernel<float>, &sweepScalarKernel<int>, &sweepScalarKernel<double>,
+            &countScalar};
+}
+
+auto bestIsa() -> Isa {
+    for (Isa isa : {Isa::Avx512, Isa::Avx2, Isa::Sse4}) {
+        if (isSupported(isa)) return isa;
+    }
+    return Isa::Scalar;
+}
+
+auto active() -> Kernels& {
+    static Kernels kernels = kernelsFor(bestIsa());
+    return kernels;
+}
+
+} // namespace
+
+void sweep(const float* col, std::size_t n, const Test& test, std::uint8_t* mask) {
+    active().sweepFloat(col, n, test, mask);
+}
+
+void sweep(const int* col, std::size_t n, const Test& test, std::uint8_t* mask) {
+    active().sweepInt(col, n, test, mask);
+}
+
+void sweep(const double* col, std::size_t n, const Test& test, std::uint8_t* mask) {
+    active().sweepDouble(col, n, test, mask);
+}
+
+auto count(const std::uint8_t* mask, std::size_t n) -> std::size_t {
+    return active().count(mask, n);
+}
+
+auto compact(const std::uint8_t* mask, std::size_t n, int* idx) -> std::size_t {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        idx[k] = static_cast<int>(i);
+        k += mask[i];
+    }
+    return k;
+}
+
+auto getIsa() -> Isa {
+    return active().isa;
+}
+
+void setIsa(Isa isa) {
+    if (!isSupported(isa)) {
+        throw std::runtime_error(std::string("CutKernels::setIsa: ") + isaName(isa) + " is not supported by this CPU");
+    }
+    active() = kernelsFor(isa);
+}
+
+auto isSupported(Isa isa) -> bool {
+    __builtin_cpu_init();
+    switch (isa) {
+        case Isa::Scalar: return true;
+        case Isa::Sse4: return __builtin_cpu_supports("sse4.2");
+        case Isa::Avx2: return __builtin_cpu_supports("avx2");
+        case Isa::Avx512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                   __builtin_cpu_supports("avx512vl");
+    }
+    return false;
+}
+
+auto isaName(Isa isa) -> const char* {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::Sse4: return "SSE4.2";
+        case Isa::Avx2: return "AVX2";
+        case Isa::Avx512: return "AVX-512";
+    }
+    return "unknown";
+}
+
+} // namespace CutKernels
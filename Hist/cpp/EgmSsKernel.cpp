@@ -0,0 +1,68 @@
+#include "EgmSsKernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace EgmSsKernel {
+
+auto eleSsCorrection(double pt, double eta, double mass, double eCorr) -> double {
+    // Calculate energy from pt, eta, and mass
+    double energy = std::sqrt(std::pow(pt * std::cosh(eta), 2) + std::pow(mass, 2));
+    double corrE = eCorr * energy;
+
+    // Convert corrected energy back to new pT
+    double newPt = std::sqrt((std::pow(corrE, 2) - std::pow(mass, 2)) / std::pow(std::cosh(eta), 2));
+    return newPt / pt;
+}
+
+// pow(x, 2) is exactly x*x (both are correctly rounded), so the results match
+// eleSsCorrection bit for bit
+void eleSsCorrections(std::size_t n, const float* pt, const float* eta, const float* mass, const float* eCorr,
+                      double* corr) {
+    constexpr std::size_t kBlock = 64;
+    double coshEta[kBlock];
+    for (std::size_t start = 0; start < n; start += kBlock) {
+        const std::size_t m = std::min(kBlock, n - start);
+        const float* ptB = pt + start;
+        const float* massB = mass + start;
+        const float* eCorrB = eCorr + start;
+        double* corrB = corr + start;
+        for (std::size_t i = 0; i < m; ++i) coshEta[i] = std::cosh(static_cast<double>(eta[start + i]));
+        for (std::size_t i = 0; i < m; ++i) {
+            const double p = ptB[i];
+            const double m2 = static_cast<double>(massB[i]) * static_cast<double>(massB[i]);
+            const double pz = p * coshEta[i];
+            const double corrE = eCorrB[i] * std::sqrt(pz * pz + m2);
+            corrB[i] = std::sqrt((corrE * corrE - m2) / (coshEta[i] * coshEta[i])) / p;
+        }
+    }
+}
+
+// Same argument types as the initializer lists of ScaleObject::getPhoScaleCorrection:
+// seedGain (UChar_t) goes in as int, run as Float_t widened to double
+void phoScaleCorrections(const correction::Correction& ref, const std::string& nomOrSyst, unsigned int run,
+                         std::size_t n, const unsigned char* seedGain, const float* eta, const float* r9,
+                         const float* pt, double* corr) {
+    std::vector<correction::Variable::Type> args{nomOrSyst, 0, static_cast<double>(static_cast<float>(run)), 0.0,
+                                                 0.0, 0.0};
+    for (std::size_t i = 0; i < n; ++i) {
+        args[1] = static_cast<int>(seedGain[i]);
+        args[3] = static_cast<double>(eta[i]);
+        args[4] = static_cast<double>(r9[i]);
+        args[5] = static_cast<double>(pt[i]);
+        corr[i] = ref.evaluate(args);
+    }
+}
+
+void phoSmearCorrections(const correction::Correction& ref, const std::string& nomOrSyst, std::size_t n,
+                         const float* eta, const float* r9, double* corr) {
+    std::vector<correction::Variable::Type> args{nomOrSyst, 0.0, 0.0};
+    for (std::size_t i = 0; i < n; ++i) {
+        args[1] = static_cast<double>(eta[i]);
+        args[2] = static_cast<double>(r9[i]);
+        corr[i] = ref.evaluate(args);
+    }
+}
+
+} // namespace EgmSsKernel
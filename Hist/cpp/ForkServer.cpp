@@ -0,0 +1,127 @@
+#include "ForkServer.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+ForkServer::ForkServer(int nWorkers, const std::string& logDir)
+    : nWorkers_(nWorkers), logDir_(logDir) {
+    if (nWorkers_ <= 0) {
+        nWorkers_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::cout << "+ ForkServer initialized with " << nWorkers_ << " workers" << '\n';
+}
+
+std::vector<std::string> ForkServer::readJobList(const std::string& fileName) {
+    std::ifstream inFile(fileName);
+    if (!inFile) {
+        throw std::runtime_error("Unable to open job list: " + fileName);
+    }
+    std::vector<std::string> jobs;
+    std::string line;
+    while (std::getline(inFile, line)) {
+        const auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        const auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos) continue;
+        const auto last = line.find_last_not_of(" \t\r");
+        jobs.push_back(line.substr(first, last - first + 1));
+    }
+    if (jobs.empty()) {
+        throw std::runtime_error("No jobs found in job list: " + fileName);
+    }
+    return jobs;
+}
+
+auto ForkServer::getLogPath(const std::string& job) const -> std::string {
+    std::istringstream iss(job);
+    std::string name;
+    iss >> name;
+    return logDir_ + "/" + name + ".log";
+}
+
+auto ForkServer::run(const std::vector<std::string>& jobs,
+                     const std::function<int(const std::string&)>& work) -> int {
+    std::cout << "==> run(): " << jobs.size() << " jobs" << '\n';
+    std::map<pid_t, std::string> running;
+    size_t nextJob = 0;
+    int nFailed = 0;
+
+    while (nextJob < jobs.size() || !running.empty()) {
+        // Fill the free worker slots
+        while (nextJob < jobs.size() && static_cast<int>(running.size()) < nWorkers_) {
+            const std::string& job = jobs[nextJob++];
+            // Do not let the child inherit (and flush again) pending output
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+
+            const pid_t pid = fork();
+            if (pid < 0) {
+                throw std::runtime_error(std::string("fork() failed: ") + std::strerror(errno));
+            }
+            if (pid == 0) {
+                const std::string logPath = getLogPath(job);
+                // One open file for both streams, so that flushing stdout
+                // cannot overwrite what stderr wrote meanwhile
+                if (!std::freopen(logPath.c_str(), "w", stdout) ||
+                    dup2(fileno(stdout), fileno(stderr)) < 0) {
+                    std::_Exit(EXIT_FAILURE);
+                }
+                int code = EXIT_FAILURE;
+                // Nothing may unwind into the job loop of the parent copy
+                try {
+                    code = work(job);
+                } catch (const std::exception& e) {
+                    std::cerr << "EXCEPTION: " << e.what() << '\n';
+                } catch (...) {
+                    std::cerr << "EXCEPTION: unknown exception in job " << job << '\n';
+                }
+                Logger::flushIfCreated();
+                std::cout.flush();
+                std::cerr.flush();
+                std::fflush(nullptr);
+                // Skip the static destructors of the parent copy
+                _exit(code);
+            }
+            running.emplace(pid, job);
+            std::cout << "Started [" << pid << "] " << job << '\n';
+        }
+
+        int status = 0;
+        const pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("waitpid() failed: ") + std::strerror(errno));
+        }
+        auto it = running.find(pid);
+        if (it == running.end()) continue;
+
+        const bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        if (ok) {
+            std::cout << "Done    [" << pid << "] " << it->second << '\n';
+        } else {
+            ++nFailed;
+            std::cerr << "Failed  [" << pid << "] " << it->second;
+            if (WIFSIGNALED(status)) std::cerr << " (signal " << WTERMSIG(status) << ")";
+            else std::cerr << " (exit code " << WEXITSTATUS(status) << ")";
+            std::cerr << ", see " << getLogPath(it->second) << '\n';
+        }
+        running.erase(it);
+    }
+
+    std::cout << "Finished " << jobs.size() << " jobs, failed: " << nFailed << '\n';
+    return nFailed;
+}
@@ -43,6 +43,24 @@ std::string GlobalFlag::getYearStr() const {
     }
 }
 
+std::string GlobalFlag::getEraStr() const {
+    switch(era_) {
+        case Era::Era2016PreBCD:  return "Era2016PreBCD";
+        case Era::Era2016PreEF:   return "Era2016PreEF";
+        case Era::Era2016PostFGH: return "Era2016PostFGH";
+        case Era::Era2017B:       return "Era2017B";
+        case Era::Era2017C:       return "Era2017C";
+        case Era::Era2017D:       return "Era2017D";
+        case Era::Era2017E:       return "Era2017E";
+        case Era::Era2017F:       return "Era2017F";
+        case Era::Era2018A:       return "Era2018A";
+        case Era::Era2018B:       return "Era2018B";
+        case Era::Era2018C:       return "Era2018C";
+        case Era::Era2018D:       return "Era2018D";
+        default:                  return "";
+    }
+}
+
 double GlobalFlag::getLumiPerYear() const {
     switch(year_) {
         case Year::Year2016Pre:  return 19.5;
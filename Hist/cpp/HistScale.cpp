@@ -56,42 +56,42 @@ void HistScale::InitializeHistograms(TDirectory* origDir, const std::string& dir
             histNamePt.c_str(), "", nPt, binsPt.data());
     }
 
-    // Initialize correction names (should match those in ScaleJetMet)
-    jecNames_ = {
-        "Nano", "Raw", "L1RcCorr", "L2RelCorr", "L2L3ResCorr", "JerCorr", "Corr"
-    };
-
-    // Initialize histograms for Jet1 Pt
-    for (const auto& corrName : jecNames_) {
+    // Initialize histograms for Jet1 Pt (names from ScaleJetMet::levelNames)
+    for (int level = 0; level < ScaleJetMet::nLevels; ++level) {
+        const std::string corrName = ScaleJetMet::levelNames[level];
         std::string histNamePt = "h1EventInJet1Pt" + corrName;
-        histJet1Pt_[corrName] = std::make_unique<TH1D>(
+        histJet1Pt_[level] = std::make_unique<TH1D>(
             histNamePt.c_str(), "", nPt, binsPt.data());
     }
 
     // Initialize histograms for JetSum Pt
-    for (const auto& corrName : jecNames_) {
+    for (int level = 0; level < ScaleJetMet::nLevels; ++level) {
+        const std::string corrName = ScaleJetMet::levelNames[level];
         std::string histNamePt = "h1EventInJetSumPt" + corrName;
-        histJetSumPt_[corrName] = std::make_unique<TH1D>(
+        histJetSumPt_[level] = std::make_unique<TH1D>(
             histNamePt.c_str(), "", nPt, binsPt.data());
     }
 
     // Initialize histograms for MET Pt
-    for (const auto& corrName : corrNames_) {
+    for (const auto level : metLevels_) {
+        const std::string corrName = ScaleJetMet::levelNames[level];
         std::string histNamePt = "h1EventInMetPt" + corrName;
-        histMetPt_[corrName] = std::make_unique<TH1D>(
+        histMetPt_[level] = std::make_unique<TH1D>(
             histNamePt.c_str(), "", nPt, binsPt.data());
     }
     // Initialize histograms for MET Phi
-    for (const auto& corrName : corrNames_) {
+    for (const auto level : metLevels_) {
+        const std::string corrName = ScaleJetMet::levelNames[level];
         std::string histNamePhi = "h1EventInMetPhi" + corrName;
-        histMetPhi_[corrName] = std::make_unique<TH1D>(
+        histMetPhi_[level] = std::make_unique<TH1D>(
             histNamePhi.c_str(), "", nPhi, binsPhi.data());
     }
 
     // Initialize histograms for Jet + MET pTs
-    for (const auto& corrName : corrNames_) {
+    for (const auto level : metLevels_) {
+        const std::string corrName = ScaleJetMet::levelNames[level];
         std::string histNamePt = "h1EventInJetMetSumPt" + corrName;
-        histJetMetSumPt_[corrName] = std::make_unique<TH1D>(
+        histJetMetSumPt_[level] = std::make_unique<TH1D>(
             histNamePt.c_str(), "", nPt, binsPt.data());
     }
 
@@ -148,47 +148,19 @@ void HistScale::FillPhoton(const ScalePhoton& scalePhoton)
 
 void HistScale::FillJetMet(const ScaleJetMet& scaleJetMet)
 {
-    const auto& p4MapJet1 = scaleJetMet.getP4MapJet1();
-    const auto& getP4MapJetSum = scaleJetMet.getP4MapJetSum();
-
-    // Fill Jet1 histograms
-    for (const auto& corrName : jecNames_) {
-        const auto& p4Jet1Iter = p4MapJet1.find(corrName);
-        if (p4Jet1Iter != p4MapJet1.end()) {
-            const auto& p4Jet1 = p4Jet1Iter->second;
-            histJet1Pt_[corrName]->Fill(p4Jet1.Pt());
-        }
-    }
-
-    // Fill JetSum histograms
-    for (const auto& corrName : jecNames_) {
-        const auto& p4JetSumIter = getP4MapJetSum.find(corrName);
-        if (p4JetSumIter != getP4MapJetSum.end()) {
-            const auto& p4JetSum = p4JetSumIter->second;
-            histJetSumPt_[corrName]->Fill(p4JetSum.Pt());
-        }
+    // Fill Jet1 and JetSum histograms
+    for (int level = 0; level < ScaleJetMet::nLevels; ++level) {
+        const auto lv = static_cast<ScaleJetMet::Level>(level);
+        histJet1Pt_[level]->Fill(scaleJetMet.getP4Jet1(lv).pt());
+        histJetSumPt_[level]->Fill(scaleJetMet.getP4JetSum(lv).pt());
     }
 
-    const auto& p4MapMet = scaleJetMet.getP4MapMet();
-
-    // Fill MET histograms
-    for (const auto& corrName : corrNames_) {
-        const auto& p4MetIter = p4MapMet.find(corrName);
-        if (p4MetIter != p4MapMet.end()) {
-            const auto& p4Met = p4MetIter->second;
-            histMetPt_[corrName]->Fill(p4Met.Pt());
-            histMetPhi_[corrName]->Fill(p4Met.Phi());
-        }
-    }
-    // Fill Jet+MET histograms
-    for (const auto& corrName : corrNames_) {
-        const auto& p4MetIter = p4MapMet.find(corrName);
-        if (p4MetIter == p4MapMet.end()) continue;
-        const auto& p4JetSumIter = getP4MapJetSum.find(corrName);
-        if (p4JetSumIter == getP4MapJetSum.end()) continue;
-        const auto& p4Met = p4MetIter->second;
-        const auto& p4JetSum = p4JetSumIter->second;
-        histJetMetSumPt_[corrName]->Fill((p4Met + p4JetSum).Pt());
+    // Fill MET and Jet+MET histograms
+    for (const auto level : metLevels_) {
+        const P4& p4Met = scaleJetMet.getP4Met(level);
+        histMetPt_[level]->Fill(p4Met.pt());
+        histMetPhi_[level]->Fill(p4Met.phi());
+        histJetMetSumPt_[level]->Fill((p4Met + scaleJetMet.getP4JetSum(level)).pt());
     }
 }
 
@@ -0,0 +1,267 @@
+#include "JercGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+// correctionlib allows "inf", "+inf" and "-inf" as edges
+auto toEdge(const nlohmann::json& value) -> double {
+    if (value.is_string()) {
+        const auto str = value.get<std::string>();
+        if (str == "inf" || str == "+inf") return std::numeric_limits<double>::infinity();
+        if (str == "-inf") return -std::numeric_limits<double>::infinity();
+        throw std::runtime_error("Unknown bin edge " + str + " in JercGrid");
+    }
+    return value.get<double>();
+}
+
+auto toEdges(const nlohmann::json& edges) -> std::vector<double> {
+    std::vector<double> out;
+    if (edges.is_object()) { // uniform binning
+        const int n = edges.at("n").get<int>();
+        const double low = edges.at("low").get<double>();
+        const double high = edges.at("high").get<double>();
+        for (int i = 0; i <= n; ++i) out.push_back(low + (high - low) * i / n);
+        return out;
+    }
+    for (const auto& edge : edges) out.push_back(toEdge(edge));
+    return out;
+}
+
+// A finite point inside [low, high) to tabulate the cell at
+auto cellCenter(double low, double high) -> double {
+    if (std::isinf(low) && std::isinf(high)) return 0.0;
+    if (std::isinf(low)) return high - 1.0;
+    if (std::isinf(high)) return low + 1.0;
+    return 0.5 * (low + high);
+}
+
+// Index of the cell holding x, or -1 outside [edges.front(), edges.back())
+auto findCell(const CacheArray<double>& edges, double x) -> int {
+    if (!(x >= edges.front() && x < edges.back())) return -1;
+    return static_cast<int>(std::upper_bound(edges.begin(), edges.end(), x) - edges.begin()) - 1;
+}
+
+} // namespace
+
+JercGrid::JercGrid(const correction::Correction::Ref& ref, const nlohmann::json& correctionJson,
+                   const Options& options, const std::string& category)
+    : ref_(ref), name_(ref->name()), category_(category) {
+    const nlohmann::json& data = correctionJson.at("data");
+    bool hasRho = false;
+    for (const auto& var : ref_->inputs()) {
+        const std::string& name = var.name();
+        if (var.type() == correction::Variable::VarType::string) {
+            inputs_.push_back(Input::Category);
+        } else if (name == "JetEta") {
+            inputs_.push_back(Input::Eta);
+            etaEdgesStore_ = collectEdges(data, name);
+        } else if (name == "Rho") {
+            inputs_.push_back(Input::Rho);
+            rhoEdgesStore_ = collectEdges(data, name);
+            hasRho = true;
+        } else if (name == "JetPt") {
+            inputs_.push_back(Input::Pt);
+            hasPt_ = true;
+        } else {
+            throw std::runtime_error("JercGrid: input " + name + " of " + name_ + " is not supported");
+        }
+        if ((name == "JetEta" && etaEdgesStore_.size() < 2) || (name == "Rho" && rhoEdgesStore_.size() < 2)) {
+            throw std::runtime_error("JercGrid: " + name_ + " is not binned in " + name);
+        }
+    }
+    if (etaEdgesStore_.empty()) {
+        throw std::runtime_error("JercGrid: " + name_ + " has no JetEta input");
+    }
+    if (!hasRho) rhoEdgesStore_ = {-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()};
+    etaEdges_ = CacheArray<double>(etaEdgesStore_);
+    rhoEdges_ = CacheArray<double>(rhoEdgesStore_);
+
+    if (hasPt_) {
+        if (options.nPtPoints < 2 || options.ptMin <= 0 || options.ptMax <= options.ptMin) {
+            throw std::runtime_error("JercGrid: invalid pt grid for " + name_);
+        }
+        nPt_ = options.nPtPoints;
+        ptMin_ = options.ptMin;
+        ptMax_ = options.ptMax;
+        logPtMin_ = std::log(ptMin_);
+        logPtStep_ = (std::log(ptMax_) - logPtMin_) / (nPt_ - 1);
+    }
+
+    const std::size_t nEta = etaEdges_.size - 1;
+    const std::size_t nRho = rhoEdges_.size - 1;
+    valuesStore_.resize(nEta * nRho * nPt_);
+    for (std::size_t iEta = 0; iEta < nEta; ++iEta) {
+        const double eta = cellCenter(etaEdges_[iEta], etaEdges_[iEta + 1]);
+        for (std::size_t iRho = 0; iRho < nRho; ++iRho) {
+            const double rho = cellCenter(rhoEdges_[iRho], rhoEdges_[iRho + 1]);
+            double* cell = &valuesStore_[(iEta * nRho + iRho) * nPt_];
+            for (int iPt = 0; iPt < nPt_; ++iPt) {
+                const double pt = hasPt_ ? std::exp(logPtMin_ + iPt * logPtStep_) : 0.0;
+                cell[iPt] = evaluateRef(eta, pt, rho);
+            }
+        }
+    }
+    values_ = CacheArray<double>(valuesStore_);
+    std::cout << "JercGrid: " << name_ << ": " << nEta << " eta x " << nRho << " rho x "
+              << nPt_ << " pt points (" << getSizeInBytes() / 1024 << " kB)" << '\n';
+}
+
+void JercGrid::writeTo(CorrectionCacheWriter& writer, const std::string& prefix) const {
+    std::vector<double> meta = {static_cast<double>(nPt_), ptMin_, ptMax_, hasPt_ ? 1.0 : 0.0};
+    for (const auto input : inputs_) meta.push_back(static_cast<double>(input));
+    writer.add(prefix + "/meta", meta);
+    writer.add(prefix + "/eta", std::vector<double>(etaEdges_.begin(), etaEdges_.end()));
+    writer.add(prefix + "/rho", std::vector<double>(rhoEdges_.begin(), rhoEdges_.end()));
+    writer.add(prefix + "/values", std::vector<double>(values_.begin(), values_.end()));
+    writer.addText(prefix + "/category", category_);
+}
+
+auto JercGrid::isCached(const CorrectionCache& cache, const std::string& prefix, const Options& options,
+                        const std::string& category) -> bool {
+    if (!cache.has(prefix + "/values") || !cache.has(prefix + "/meta") || !cache.has(prefix + "/category")) {
+        return false;
+    }
+    if (cache.getText(prefix + "/category") != category) return false;
+    const auto meta = cache.get<double>(prefix + "/meta");
+    if (meta.size < 4) return false;
+    if (meta[3] == 0.0) return true;  // no pt axis, the options do not apply
+    return static_cast<int>(meta[0]) == options.nPtPoints && meta[1] == options.ptMin && meta[2] == options.ptMax;
+}
+
+auto JercGrid::fromCache(const std::shared_ptr<const CorrectionCache>& cache, const std::string& prefix,
+                         const correction::Correction::Ref& ref) -> std::unique_ptr<JercGrid> {
+    std::unique_ptr<JercGrid> grid(new JercGrid());
+    grid->ref_ = ref;
+    grid->name_ = ref->name();
+    grid->cache_ = cache;
+    grid->category_ = cache->getText(prefix + "/category");
+    const auto meta = cache->get<double>(prefix + "/meta");
+    if (meta.size < 4 || meta.size - 4 != ref->inputs().size()) {
+        throw std::runtime_error("JercGrid: " + prefix + " does not match the inputs of " + grid->name_);
+    }
+    grid->nPt_ = static_cast<int>(meta[0]);
+    grid->ptMin_ = meta[1];
+    grid->ptMax_ = meta[2];
+    grid->hasPt_ = meta[3] != 0.0;
+    for (std::size_t i = 4; i < meta.size; ++i) grid->inputs_.push_back(static_cast<Input>(static_cast<int>(meta[i])));
+    if (grid->hasPt_) {
+        grid->logPtMin_ = std::log(grid->ptMin_);
+        grid->logPtStep_ = (std::log(grid->ptMax_) - grid->logPtMin_) / (grid->nPt_ - 1);
+    }
+    grid->etaEdges_ = cache->get<double>(prefix + "/eta");
+    grid->rhoEdges_ = cache->get<double>(prefix + "/rho");
+    grid->values_ = cache->get<double>(prefix + "/values");
+    if (grid->values_.size != (grid->etaEdges_.size - 1) * (grid->rhoEdges_.size - 1) * grid->nPt_) {
+        throw std::runtime_error("JercGrid: inconsistent table sizes in " + prefix);
+    }
+    return grid;
+}
+
+auto JercGrid::collectEdges(const nlohmann::json& node, const std::string& input) -> std::vector<double> {
+    std::vector<double> edges;
+    std::function<void(const nlohmann::json&)> walk = [&](const nlohmann::json& n) {
+        if (n.is_array()) {
+            for (const auto& child : n) walk(child);
+            return;
+        }
+        if (!n.is_object()) return;
+        const std::string nodetype = n.value("nodetype", "");
+        if (nodetype == "binning" && n.at("input") == input) {
+            const auto nodeEdges = toEdges(n.at("edges"));
+            edges.insert(edges.end(), nodeEdges.begin(), nodeEdges.end());
+        } else if (nodetype == "multibinning") {
+            const auto& inputs = n.at("inputs");
+            for (std::size_t i = 0; i < inputs.size(); ++i) {
+                if (inputs[i] != input) continue;
+                const auto nodeEdges = toEdges(n.at("edges").at(i));
+                edges.insert(edges.end(), nodeEdges.begin(), nodeEdges.end());
+            }
+        } else if (nodetype == "transform" && n.at("input") == input) {
+            throw std::runtime_error("JercGrid: " + input + " is transformed, cannot tabulate");
+        }
+        for (const char* key : {"content", "default", "value"}) {
+            if (n.contains(key)) walk(n.at(key));
+        }
+    };
+    walk(node);
+    // Union of the edges of all sub-binnings: constant in every cell
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    return edges;
+}
+
+auto JercGrid::evaluateRef(double eta, double pt, double rho) const -> double {
+    std::vector<correction::Variable::Type> args;
+    args.reserve(inputs_.size());
+    for (const auto input : inputs_) {
+        switch (input) {
+            case Input::Eta: args.emplace_back(eta); break;
+            case Input::Rho: args.emplace_back(rho); break;
+            case Input::Pt: args.emplace_back(pt); break;
+            case Input::Category: args.emplace_back(category_); break;
+        }
+    }
+    return ref_->evaluate(args);
+}
+
+auto JercGrid::evaluate(double eta, double pt, double rho) const -> double {
+    const int iEta = findCell(etaEdges_, eta);
+    const int iRho = findCell(rhoEdges_, rho);
+    if (iEta < 0 || iRho < 0 || (hasPt_ && !(pt >= ptMin_ && pt < ptMax_))) {
+        return evaluateRef(eta, pt, rho);
+    }
+    const std::size_t nRho = rhoEdges_.size - 1;
+    const double* cell = &values_[(iEta * nRho + iRho) * nPt_];
+    if (!hasPt_) return cell[0];
+    const double x = (std::log(pt) - logPtMin_) / logPtStep_;
+    const int iPt = std::min(static_cast<int>(x), nPt_ - 2);
+    const double frac = x - iPt;
+    return cell[iPt] + frac * (cell[iPt + 1] - cell[iPt]);
+}
+
+void JercGrid::evaluate(std::size_t n, const float* eta, const float* pt, const float* rho, double* out) const {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = evaluate(eta[i], pt[i], rho ? rho[i] : 0.0);
+    }
+}
+
+auto JercGrid::validate(int nPoints, unsigned int seed) const -> double {
+    // Sample inside the tabulated range, infinite edges capped
+    auto finite = [](double x, double cap) { return std::isinf(x) ? std::copysign(cap, x) : x; };
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> uEta(finite(etaEdges_.front(), 5.2), finite(etaEdges_.back(), 5.2));
+    std::uniform_real_distribution<double> uRho(std::max(0.0, finite(rhoEdges_.front(), 0.0)),
+                                                finite(rhoEdges_.back(), 70.0));
+    std::uniform_real_distribution<double> uLogPt(std::log(hasPt_ ? ptMin_ : 10.0), std::log(hasPt_ ? ptMax_ : 10.0));
+
+    double maxAbs = 0.0;
+    double maxRel = 0.0;
+    double worstEta = 0.0;
+    double worstPt = 0.0;
+    for (int i = 0; i < nPoints; ++i) {
+        const double eta = uEta(gen);
+        const double rho = uRho(gen);
+        const double pt = std::exp(uLogPt(gen));
+        const double ref = evaluateRef(eta, pt, rho);
+        const double diff = std::abs(evaluate(eta, pt, rho) - ref);
+        const double rel = ref != 0.0 ? diff / std::abs(ref) : diff;
+        maxAbs = std::max(maxAbs, diff);
+        if (rel > maxRel) {
+            maxRel = rel;
+            worstEta = eta;
+            worstPt = pt;
+        }
+    }
+    std::cout << "JercGrid validation: " << name_ << ": " << nPoints << " points, max |diff| = "
+              << std::scientific << std::setprecision(3) << maxAbs << ", max rel = " << maxRel
+              << std::defaultfloat << " (eta = " << worstEta << ", pt = " << worstPt << ")" << '\n';
+    return maxRel;
+}
@@ -0,0 +1,153 @@
+#include "JetVetoBitmap.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+auto toEdges(const nlohmann::json& edges) -> std::vector<double> {
+    std::vector<double> out;
+    if (edges.is_object()) { // uniform binning
+        const int n = edges.at("n").get<int>();
+        const double low = edges.at("low").get<double>();
+        const double high = edges.at("high").get<double>();
+        for (int i = 0; i <= n; ++i) out.push_back(low + (high - low) * i / n);
+        return out;
+    }
+    for (const auto& edge : edges) out.push_back(edge.get<double>());
+    return out;
+}
+
+// Largest i with edges[i] <= x, for edges[0] <= x < edges[size - 1].
+// The loop has a fixed trip count and compiles to conditional moves.
+inline auto findCell(const CacheArray<double>& edges, double x) -> std::size_t {
+    const double* base = edges.data;
+    std::size_t n = edges.size - 1;
+    while (n > 1) {
+        const std::size_t half = n / 2;
+        base = (base[half] <= x) ? base + half : base;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - edges.data);
+}
+
+inline auto inRange(const CacheArray<double>& edges, double x) -> bool {
+    return x >= edges.front() && x < edges.back();
+}
+
+} // namespace
+
+JetVetoBitmap::JetVetoBitmap(const correction::Correction::Ref& ref, const nlohmann::json& correctionJson,
+                             const std::string& key)
+    : ref_(ref), key_(key) {
+    const nlohmann::json& data = correctionJson.at("data");
+    const nlohmann::json* node = nullptr;
+    if (data.value("nodetype", "") == "category") {
+        for (const auto& item : data.at("content")) {
+            if (item.at("key") == key) node = &item.at("value");
+        }
+    }
+    if (!node || node->value("nodetype", "") != "multibinning" || node->at("inputs").size() != 2 ||
+        node->at("inputs")[0] != "eta" || node->at("inputs")[1] != "phi") {
+        throw std::runtime_error("JetVetoBitmap: " + key + " of " + ref->name() + " is not an (eta, phi) multibinning");
+    }
+    etaEdgesStore_ = toEdges(node->at("edges")[0]);
+    phiEdgesStore_ = toEdges(node->at("edges")[1]);
+    const std::size_t nEta = etaEdgesStore_.size() - 1;
+    const std::size_t nPhi = phiEdgesStore_.size() - 1;
+    const auto& content = node->at("content");
+    if (content.size() != nEta * nPhi) {
+        throw std::runtime_error("JetVetoBitmap: content of " + key + " does not match its binning");
+    }
+    bitsStore_.assign((nEta * nPhi + 63) / 64, 0);
+    for (std::size_t i = 0; i < content.size(); ++i) {
+        if (!content[i].is_number()) {
+            throw std::runtime_error("JetVetoBitmap: " + key + " has non-constant cells");
+        }
+        if (content[i].get<double>() > 0) bitsStore_[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+    etaEdges_ = CacheArray<double>(etaEdgesStore_);
+    phiEdges_ = CacheArray<double>(phiEdgesStore_);
+    bits_ = CacheArray<std::uint64_t>(bitsStore_);
+    std::cout << "JetVetoBitmap: " << ref->name() << "/" << key << ": " << nEta << " eta x " << nPhi
+              << " phi bins (" << bitsStore_.size() * sizeof(std::uint64_t) << " bytes)" << '\n';
+}
+
+void JetVetoBitmap::writeTo(CorrectionCacheWriter& writer, const std::string& prefix) const {
+    writer.add(prefix + "/eta", std::vector<double>(etaEdges_.begin(), etaEdges_.end()));
+    writer.add(prefix + "/phi", std::vector<double>(phiEdges_.begin(), phiEdges_.end()));
+    writer.add(prefix + "/bits", std::vector<std::uint64_t>(bits_.begin(), bits_.end()));
+    writer.addText(prefix + "/key", key_);
+}
+
+auto JetVetoBitmap::fromCache(const std::shared_ptr<const CorrectionCache>& cache, const std::string& prefix,
+                              const correction::Correction::Ref& ref) -> std::unique_ptr<JetVetoBitmap> {
+    std::unique_ptr<JetVetoBitmap> bitmap(new JetVetoBitmap());
+    bitmap->ref_ = ref;
+    bitmap->cache_ = cache;
+    bitmap->key_ = cache->getText(prefix + "/key");
+    bitmap->etaEdges_ = cache->get<double>(prefix + "/eta");
+    bitmap->phiEdges_ = cache->get<double>(prefix + "/phi");
+    bitmap->bits_ = cache->get<std::uint64_t>(prefix + "/bits");
+    const std::size_t nBits = (bitmap->etaEdges_.size - 1) * (bitmap->phiEdges_.size - 1);
+    if (bitmap->etaEdges_.size < 2 || bitmap->phiEdges_.size < 2 || bitmap->bits_.size != (nBits + 63) / 64) {
+        throw std::runtime_error("JetVetoBitmap: inconsistent table sizes in " + prefix);
+    }
+    return bitmap;
+}
+
+auto JetVetoBitmap::isVetoedRef(double eta, double phi) const -> bool {
+    return ref_->evaluate({key_, eta, phi}) > 0;
+}
+
+auto JetVetoBitmap::isVetoed(double eta, double phi) const -> bool {
+    if (!inRange(etaEdges_, eta) || !inRange(phiEdges_, phi)) {
+        return isVetoedRef(eta, phi);
+    }
+    const std::size_t bit = findCell(etaEdges_, eta) * (phiEdges_.size - 1) + findCell(phiEdges_, phi);
+    return (bits_[bit / 64] >> (bit % 64)) & 1U;
+}
+
+auto JetVetoBitmap::isAnyVetoed(std::size_t n, const float* eta, const float* phi, const std::uint8_t* use) const
+    -> bool {
+    const std::size_t nPhi = phiEdges_.size - 1;
+    std::uint64_t any = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!use[i]) continue;
+        if (!inRange(etaEdges_, eta[i]) || !inRange(phiEdges_, phi[i])) {
+            any |= isVetoedRef(eta[i], phi[i]);
+            continue;
+        }
+        const std::size_t bit = findCell(etaEdges_, eta[i]) * nPhi + findCell(phiEdges_, phi[i]);
+        any |= (bits_[bit / 64] >> (bit % 64)) & 1U;
+    }
+    return any != 0;
+}
+
+void JetVetoBitmap::validate(int nRandom, unsigned int seed) const {
+    auto check = [&](double eta, double phi) {
+        if (isVetoed(eta, phi) != isVetoedRef(eta, phi)) {
+            throw std::runtime_error("JetVetoBitmap: " + key_ + " differs from correctionlib at eta = " +
+                                     std::to_string(eta) + ", phi = " + std::to_string(phi));
+        }
+    };
+    for (std::size_t iEta = 0; iEta + 1 < etaEdges_.size; ++iEta) {
+        for (std::size_t iPhi = 0; iPhi + 1 < phiEdges_.size; ++iPhi) {
+            check(0.5 * (etaEdges_[iEta] + etaEdges_[iEta + 1]), 0.5 * (phiEdges_[iPhi] + phiEdges_[iPhi + 1]));
+            check(etaEdges_[iEta], phiEdges_[iPhi]);
+        }
+    }
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> uEta(etaEdges_.front(), etaEdges_.back());
+    std::uniform_real_distribution<double> uPhi(phiEdges_.front(), phiEdges_.back());
+    for (int i = 0; i < nRandom; ++i) {
+        // Jets come as floats, which may round onto the outer edges
+        const double eta = static_cast<float>(uEta(gen));
+        const double phi = static_cast<float>(uPhi(gen));
+        if (inRange(etaEdges_, eta) && inRange(phiEdges_, phi)) check(eta, phi);
+    }
+    std::cout << "JetVetoBitmap: " << key_ << " agrees with correctionlib on "
+              << 2 * (etaEdges_.size - 1) * (phiEdges_.size - 1) + nRandom << " points" << '\n';
+}
@@ -1,5 +1,12 @@
 #include "Logger.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+#include <pthread.h>
+
 // ANSI color codes for different log levels
 const std::string COLOR_DEBUG = "\033[36m";  // Cyan
 const std::string COLOR_INFO = "\033[32m";   // Green
@@ -9,58 +16,193 @@ const std::string COLOR_CRITICAL = "\033[1;31m"; // Bold Red
 const std::string COLOR_RESET = "\033[0m";   // Reset color
 
 // Initialize the global console log level to INFO
-LogLevel Logger::consoleLogLevel = INFO;
-
-// Singleton instance of Logger
-Logger* Logger::instance = nullptr;
+std::atomic<LogLevel> Logger::consoleLogLevel{INFO};
+std::atomic<bool> Logger::hasLogFile{false};
+std::atomic<Logger*> Logger::instance_{nullptr};
 
-// Get the singleton instance of the logger
+// Get the singleton instance of the logger. Destroyed at exit, which
+// writes the pending records and joins the writer thread.
 auto Logger::getInstance() -> Logger& {
-    if (instance == nullptr) {
-        instance = new Logger();
+    static Logger instance;
+    return instance;
+}
+
+Logger::Logger() {
+    for (std::size_t i = 0; i < kCapacity; ++i) {
+        slots_[i].seq.store(i, std::memory_order_relaxed);
     }
-    return *instance;
+    startWriter();
+    instance_.store(this, std::memory_order_release);
+    // A forked child (ForkServer) only has the thread that called fork():
+    // the writer is stopped before fork() and started again in both processes
+    static const bool atforkRegistered = [] {
+        pthread_atfork(&Logger::beforeFork, &Logger::afterFork, &Logger::afterFork);
+        return true;
+    }();
+    (void)atforkRegistered;
+}
+
+Logger::~Logger() {
+    instance_.store(nullptr, std::memory_order_release);
+    stopWriter();
+}
+
+// Writes everything pending and joins the writer thread; the caller then
+// owns logFile until startWriter()
+void Logger::stopWriter() {
+    if (!writer_.joinable()) return;
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+    stop_.store(false, std::memory_order_relaxed);
+}
+
+void Logger::startWriter() {
+    writer_ = std::thread(&Logger::writerLoop, this);
 }
 
-// Initialize the logger with a file name
+void Logger::beforeFork() {
+    if (Logger* logger = instance_.load(std::memory_order_acquire)) logger->stopWriter();
+}
+
+void Logger::afterFork() {
+    if (Logger* logger = instance_.load(std::memory_order_acquire)) logger->startWriter();
+}
+
+// Initialize the logger with a file name. The writer thread is stopped
+// while the file is opened, so it never sees a half-opened stream.
 void Logger::init(const std::string& filename)
 {
+    stopWriter();
     if (!logFile.is_open()) {
         logFile.open(filename, std::ios::app);
-        if (!logFile.is_open()) {
+        if (logFile.is_open()) {
+            hasLogFile.store(true, std::memory_order_relaxed);
+        } else {
             std::cerr << "Error opening log file." << '\n';
         }
     }
+    startWriter();
 }
 
 // Sets the console log level to filter console output
 void Logger::setConsoleLogLevel(LogLevel level) {
-    consoleLogLevel = level;
+    consoleLogLevel.store(level, std::memory_order_relaxed);
 }
 
 // General log function that handles all levels
 void Logger::log(LogLevel level, const std::string& message)
 {
-    // Get current timestamp
-    time_t now = time(nullptr);
-    tm* timeinfo = localtime(&now);
-    char timestamp[20];
-    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", timeinfo);
+    if (!isEnabled(level)) return;
+    push(level, message);
+}
+
+// Claim the next position, wait while its slot is still in use (buffer
+// full), copy the record and publish it to the writer thread
+void Logger::push(LogLevel level, const std::string& message)
+{
+    std::size_t pos = head_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    for (;;) {
+        slot = &slots_[pos & (kCapacity - 1)];
+        const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (diff < 0) {
+            std::this_thread::yield();
+            pos = head_.load(std::memory_order_relaxed);
+        } else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
 
-    // Create log entry
-    std::ostringstream logEntry;
-    logEntry << "[" << timestamp << "] " << levelToString(level) << ": " << message << '\n';
+    Record& record = slot->record;
+    record.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record.level = static_cast<std::uint8_t>(level);
+    const std::size_t size = std::min<std::size_t>(message.size(), UINT32_MAX);
+    record.size = static_cast<std::uint32_t>(size);
+    record.longText = size > kTextSize ? new char[size] : nullptr;
+    std::memcpy(record.longText ? record.longText : record.text, message.data(), size);
+    slot->seq.store(pos + 1, std::memory_order_release);
+}
+
+// Writer thread: drain the buffer, flush the file when it is empty, stop
+// once the destructor is called and everything is written
+void Logger::writerLoop()
+{
+    int idle = 0;
+    for (;;) {
+        Slot& slot = slots_[tail_ & (kCapacity - 1)];
+        if (slot.seq.load(std::memory_order_acquire) == tail_ + 1) {
+            write(slot.record);
+            delete[] slot.record.longText;
+            slot.record.longText = nullptr;
+            slot.seq.store(tail_ + kCapacity, std::memory_order_release);
+            ++tail_;
+            written_.store(tail_, std::memory_order_release);
+            idle = 0;
+            continue;
+        }
+        if (idle == 0) {
+            std::cout.flush();
+            if (logFile.is_open()) logFile.flush();
+        }
+        if (stop_.load(std::memory_order_acquire) &&
+            head_.load(std::memory_order_acquire) == tail_) {
+            break;
+        }
+        if (++idle < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void Logger::write(const Record& record)
+{
+    // Writer thread only. Same time stamp for all records of one second
+    static std::time_t lastSecond = -1;
+    static char timestamp[20];
+    const std::time_t second = static_cast<std::time_t>(record.timeNs / 1000000000);
+    if (second != lastSecond) {
+        std::tm timeinfo{};
+        localtime_r(&second, &timeinfo);
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &timeinfo);
+        lastSecond = second;
+    }
+
+    const auto level = static_cast<LogLevel>(record.level);
+    std::string entry;
+    entry.reserve(record.size + 40);
+    entry.append("[").append(timestamp).append("] ").append(levelToString(level)).append(": ");
+    entry.append(record.longText ? record.longText : record.text, record.size).append(1, '\n');
 
     // Output to console only if the log level meets or exceeds the console log level
-    if (level >= consoleLogLevel) {
-        std::cout << getColorCode(level) << logEntry.str() << resetColor();
+    if (level >= consoleLogLevel.load(std::memory_order_relaxed)) {
+        std::cout << getColorCode(level) << entry << resetColor();
     }
 
     // Output to log file for all levels
     if (logFile.is_open()) {
-        logFile << logEntry.str();
-        logFile.flush(); // Ensure immediate write to file
+        logFile << entry;
+    }
+}
+
+// Wait until the writer thread has written everything pushed before the call
+void Logger::flush()
+{
+    const std::size_t target = head_.load(std::memory_order_acquire);
+    while (written_.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
     }
+    std::cout.flush();
+}
+
+void Logger::flushIfCreated()
+{
+    if (Logger* logger = instance_.load(std::memory_order_acquire)) logger->flush();
 }
 
 // Logging functions for specific severity levels
@@ -126,4 +268,3 @@ auto Logger::getColorCode(LogLevel level) -> std::string
 auto Logger::resetColor() -> std::string {
     return COLOR_RESET;
 }
-
@@ -0,0 +1,179 @@
+#include "ObjectCuts.h"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+namespace {
+
+constexpr double inf = std::numeric_limits<double>::infinity();
+
+inline auto below(double a) -> double { return std::nextafter(a, -inf); }
+inline auto above(double a) -> double { return std::nextafter(a, inf); }
+
+// Keep idx[i] if pass(value of idx[i]); branch-free compaction
+template <typename Value, typename Pass>
+inline auto compact(Value value, int* idx, std::size_t n, Pass pass) -> std::size_t {
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const int j = idx[i];
+        idx[k] = j;
+        k += pass(value(j)) ? 1 : 0;
+    }
+    return k;
+}
+
+// The Op switch is outside the candidate loop
+template <typename Value>
+auto applyOp(ObjectCuts::Op op, double a, double b, Value value, int* idx, std::size_t n) -> std::size_t {
+    switch (op) {
+        case ObjectCuts::Lt: return compact(value, idx, n, [a](double x) { return x < a; });
+        case ObjectCuts::Le: return compact(value, idx, n, [a](double x) { return x <= a; });
+        case ObjectCuts::Gt: return compact(value, idx, n, [a](double x) { return x > a; });
+        case ObjectCuts::Ge: return compact(value, idx, n, [a](double x) { return x >= a; });
+        case ObjectCuts::Eq: return compact(value, idx, n, [a](double x) { return x == a; });
+        case ObjectCuts::Ne: return compact(value, idx, n, [a](double x) { return x != a; });
+        case ObjectCuts::AbsLt: return compact(value, idx, n, [a](double x) { return std::abs(x) < a; });
+        case ObjectCuts::AbsLe: return compact(value, idx, n, [a](double x) { return std::abs(x) <= a; });
+        case ObjectCuts::AbsGt: return compact(value, idx, n, [a](double x) { return std::abs(x) > a; });
+        case ObjectCuts::AbsGe: return compact(value, idx, n, [a](double x) { return std::abs(x) >= a; });
+        case ObjectCuts::AbsOutside:
+            return compact(value, idx, n, [a, b](double x) { return std::abs(x) < a || std::abs(x) > b; });
+    }
+    return n;
+}
+
+// Float_t, Int_t (and double) columns go to the vectorised kernels
+template <typename T>
+inline void sweepValues(const T* col, std::size_t n, const CutKernels::Test& test, std::uint8_t* mask) {
+    CutKernels::sweepScalar(col, n, test, mask);
+}
+inline void sweepValues(const float* col, std::size_t n, const CutKernels::Test& test, std::uint8_t* mask) {
+    CutKernels::sweep(col, n, test, mask);
+}
+inline void sweepValues(const int* col, std::size_t n, const CutKernels::Test& test, std::uint8_t* mask) {
+    CutKernels::sweep(col, n, test, mask);
+}
+
+} // namespace
+
+auto ObjectCuts::cut(const std::string& name, Computed computed, Op op, double value, double value2)
+    -> ObjectCuts& {
+    Cut c{name, op, value, value2, makeTest(op, value, value2), nullptr, &filterComputed, &sweepComputed};
+    c.computed = computed;
+    return add(std::move(c));
+}
+
+auto ObjectCuts::makeTest(Op op, double a, double b) -> CutKernels::Test {
+    using CutKernels::Mode;
+    switch (op) {
+        case Lt: return {Mode::Inside, false, -inf, below(a)};
+        case Le: return {Mode::Inside, false, -inf, a};
+        case Gt: return {Mode::Inside, false, above(a), inf};
+        case Ge: return {Mode::Inside, false, a, inf};
+        case Eq: return {Mode::Inside, false, a, a};
+        case Ne: return {Mode::NotInside, false, a, a};
+        case AbsLt: return {Mode::Inside, true, -inf, below(a)};
+        case AbsLe: return {Mode::Inside, true, -inf, a};
+        case AbsGt: return {Mode::Inside, true, above(a), inf};
+        case AbsGe: return {Mode::Inside, true, a, inf};
+        case AbsOutside: return {Mode::Outside, true, below(a), above(b)};
+    }
+    return {Mode::Inside, false, -inf, inf};
+}
+
+auto ObjectCuts::add(Cut&& c) -> ObjectCuts& {
+    cuts_.push_back(std::move(c));
+    nPass_.push_back(0);
+    return *this;
+}
+
+template <typename T>
+auto ObjectCuts::filterColumn(const Cut& cut, const SkimTree& skimT, int* idx, std::size_t n) -> std::size_t {
+    const T* column = static_cast<const T*>(cut.column(skimT));
+    return applyOp(cut.op, cut.value, cut.value2,
+                   [column](int j) { return static_cast<double>(column[j]); }, idx, n);
+}
+
+template std::size_t ObjectCuts::filterColumn<Float_t>(const Cut&, const SkimTree&, int*, std::size_t);
+template std::size_t ObjectCuts::filterColumn<Int_t>(const Cut&, const SkimTree&, int*, std::size_t);
+template std::size_t ObjectCuts::filterColumn<Bool_t>(const Cut&, const SkimTree&, int*, std::size_t);
+template std::size_t ObjectCuts::filterColumn<UChar_t>(const Cut&, const SkimTree&, int*, std::size_t);
+template std::size_t ObjectCuts::filterColumn<Short_t>(const Cut&, const SkimTree&, int*, std::size_t);
+
+auto ObjectCuts::filterComputed(const Cut& cut, const SkimTree& skimT, int* idx, std::size_t n) -> std::size_t {
+    const Computed computed = cut.computed;
+    return applyOp(cut.op, cut.value, cut.value2,
+                   [computed, &skimT](int j) { return computed(skimT, j); }, idx, n);
+}
+
+template <typename T>
+void ObjectCuts::sweepColumn(const Cut& cut, const SkimTree& skimT, std::size_t n, std::uint8_t* mask,
+                             std::vector<double>&) {
+    sweepValues(static_cast<const T*>(cut.column(skimT)), n, cut.test, mask);
+}
+
+template void ObjectCuts::sweepColumn<Float_t>(const Cut&, const SkimTree&, std::size_t, std::uint8_t*,
+                                               std::vector<double>&);
+template void ObjectCuts::sweepColumn<Int_t>(const Cut&, const SkimTree&, std::size_t, std::uint8_t*,
+                                             std::vector<double>&);
+template void ObjectCuts::sweepColumn<Bool_t>(const Cut&, const SkimTree&, std::size_t, std::uint8_t*,
+                                              std::vector<double>&);
+template void ObjectCuts::sweepColumn<UChar_t>(const Cut&, const SkimTree&, std::size_t, std::uint8_t*,
+                                               std::vector<double>&);
+template void ObjectCuts::sweepColumn<Short_t>(const Cut&, const SkimTree&, std::size_t, std::uint8_t*,
+                                               std::vector<double>&);
+
+void ObjectCuts::sweepComputed(const Cut& cut, const SkimTree& skimT, std::size_t n, std::uint8_t* mask,
+                               std::vector<double>& scratch) {
+    scratch.resize(n);
+    for (std::size_t i = 0; i < n; ++i) scratch[i] = cut.computed(skimT, static_cast<int>(i));
+    CutKernels::sweep(scratch.data(), n, cut.test, mask);
+}
+
+void ObjectCuts::select(const SkimTree& skimT, std::vector<int>& picked) {
+    const std::size_t nCand = count_(skimT);
+    nCandidates_ += static_cast<long long>(nCand);
+    if (nCand >= kMaskMinCandidates && CutKernels::getIsa() == CutKernels::Isa::Avx512) {
+        selectMask(skimT, nCand, picked);
+    } else {
+        selectSurvivors(skimT, nCand, picked);
+    }
+}
+
+void ObjectCuts::selectSurvivors(const SkimTree& skimT, std::size_t nCand, std::vector<int>& picked) {
+    picked.resize(nCand);
+    for (std::size_t i = 0; i < nCand; ++i) picked[i] = static_cast<int>(i);
+
+    std::size_t n = nCand;
+    for (std::size_t c = 0; c < cuts_.size() && n > 0; ++c) {
+        n = cuts_[c].filter(cuts_[c], skimT, picked.data(), n);
+        nPass_[c] += static_cast<long long>(n);
+    }
+    picked.resize(n);
+}
+
+void ObjectCuts::selectMask(const SkimTree& skimT, std::size_t nCand, std::vector<int>& picked) {
+    mask_.assign(nCand, 1);
+    std::size_t n = nCand;
+    for (std::size_t c = 0; c < cuts_.size() && n > 0; ++c) {
+        cuts_[c].sweep(cuts_[c], skimT, nCand, mask_.data(), scratch_);
+        n = CutKernels::count(mask_.data(), nCand);
+        nPass_[c] += static_cast<long long>(n);
+    }
+    picked.resize(nCand);
+    picked.resize(n > 0 ? CutKernels::compact(mask_.data(), nCand, picked.data()) : 0);
+}
+
+void ObjectCuts::print(std::ostream& out) const {
+    out << object_ << " selection: " << nCandidates_ << " candidates" << '\n';
+    for (std::size_t c = 0; c < cuts_.size(); ++c) {
+        out << "  " << std::left << std::setw(16) << cuts_[c].name << std::right << std::setw(14) << nPass_[c];
+        if (nCandidates_ > 0) {
+            out << "  (" << std::fixed << std::setprecision(2) << 100.0 * nPass_[c] / nCandidates_ << "%)";
+            out << std::defaultfloat;
+        }
+        out << '\n';
+    }
+}
@@ -1,4 +1,7 @@
 #include "PickEvent.h"
+#include "Logger.h"
+
+#include <limits>
 
 // Constructor implementation
 PickEvent::PickEvent(GlobalFlag& globalFlags) : 
@@ -8,6 +11,25 @@ PickEvent::PickEvent(GlobalFlag& globalFlags) :
     channel_(globalFlags_.getChannel()),
     isMC_(globalFlags_.isMC()),
     isDebug_(globalFlags_.isDebug()){
+    for (const auto& [trigName, trigRangePt] : trigDetail_.getTrigMapRangePt()) {
+        trigsPt_.push_back({trigName, trigRangePt, -1});
+    }
+    for (const auto& [trigName, trigRangePtEta] : trigDetail_.getTrigMapRangePtEta()) {
+        trigsPtEta_.push_back({trigName, trigRangePtEta, -1});
+    }
+
+    std::vector<TrigRegionTable::Region> regions;
+    for (const auto& trig : trigsPt_) {
+        regions.push_back({trig.name, trig.range.ptMin, trig.range.ptMax,
+                           0.0, std::numeric_limits<double>::infinity()});
+    }
+    regionsPt_ = TrigRegionTable(regions);
+    regions.clear();
+    for (const auto& trig : trigsPtEta_) {
+        regions.push_back({trig.name, trig.range.ptMin, trig.range.ptMax,
+                           trig.range.absEtaMin, trig.range.absEtaMax});
+    }
+    regionsPtEta_ = TrigRegionTable(regions);
 }
 
 // Destructor
@@ -22,40 +44,38 @@ void PickEvent::printDebug(const std::string& message) const {
     }
 }
 
+void PickEvent::setTrigIds(const SkimTree& skimT) {
+    for (auto& trig : trigsPt_) trig.id = skimT.getTrigId(trig.name);
+    for (auto& trig : trigsPtEta_) trig.id = skimT.getTrigId(trig.name);
+    hasTrigIds_ = true;
+}
 
 bool PickEvent::passHlt(const std::shared_ptr<SkimTree>& skimT){
-    printDebug("<- PickEvent::passHlt ->");
-    passedHlts_.clear();
-    bool isPass = false;
-    for (const auto& trigName : skimT->getTrigNames()){
-        const auto& trigValue = static_cast<int>(skimT->getTrigValue(trigName));
-        if (trigValue) {
-            passedHlts_.push_back(trigName);
-            printDebug(trigName + ": "+ std::to_string(trigValue));
-            isPass = true;
+    PRINT_DEBUG("<- PickEvent::passHlt ->");
+    passedHltBits_ = skimT->getTrigBits();
+    if (isDebug_) {
+        const auto& trigNames = skimT->getTrigNames();
+        for (size_t id = 0; id < trigNames.size(); ++id) {
+            if (passedHltBits_.test(id)) printDebug(trigNames[id] + ": 1");
         }
     }
-    return isPass; 
+    return passedHltBits_.any();
 }
 
 auto PickEvent::passHltWithPt(const std::shared_ptr<SkimTree>& skimT, 
                               const double& pt) -> bool {
-    printDebug("<- PickEvent::passHltWithPt ->");
+    PRINT_DEBUG("<- PickEvent::passHltWithPt ->");
+    if (!hasTrigIds_) setTrigIds(*skimT);
     bool isPassedHlt = false;
     if (channel_ == GlobalFlag::Channel::GamJet) {
-        const auto& trigs = trigDetail_.getTrigMapRangePt();
-
-        // Loop over all triggers and collect those that pass
-        for (const auto& [trigName, trigRangePt] : trigs) {
-            const auto trigValue = static_cast<int>(skimT->getTrigValue(trigName));
-            if (trigValue &&
-                pt >= trigRangePt.ptMin &&
-                pt < trigRangePt.ptMax) {
+        // The only trigger whose range contains pt must have fired
+        const int index = regionsPt_.find(pt);
+        if (index >= 0) {
+            const auto& trig = trigsPt_[index];
+            if (trig.id >= 0 && skimT->getTrigValue(trig.id)) {
                 isPassedHlt = true;
-                passedHlt_ = trigName;
-                printDebug(trigName + ", pt = " + std::to_string(pt) + 
-                           " : " + std::to_string(trigValue));
-                break;
+                passedHltIndex_ = index;
+                PRINT_DEBUG(trig.name + ", pt = " + std::to_string(pt) + " : 1");
             }
         }
     }
@@ -63,30 +83,46 @@ auto PickEvent::passHltWithPt(const std::shared_ptr<SkimTree>& skimT,
     return isPassedHlt;
 }
 
+auto PickEvent::getTrigNamesRangePt() const -> std::vector<std::string> {
+    std::vector<std::string> trigNames;
+    for (const auto& trig : trigsPt_) {
+        trigNames.push_back(trig.name);
+    }
+    return trigNames;
+}
+
+auto PickEvent::getTrigNamesRangePtEta() const -> std::vector<std::string> {
+    std::vector<std::string> trigNames;
+    for (const auto& trig : trigsPtEta_) {
+        trigNames.push_back(trig.name);
+    }
+    return trigNames;
+}
+
+auto PickEvent::getPassedHlt() const -> const std::string& {
+    static const std::string none;
+    if (passedHltIndex_ < 0) return none;
+    return channel_ == GlobalFlag::Channel::MultiJet ? trigsPtEta_[passedHltIndex_].name
+                                                     : trigsPt_[passedHltIndex_].name;
+}
+
 auto PickEvent::passHltWithPtEta(const std::shared_ptr<SkimTree>& skimT, 
                                  const double& pt, 
                                  const double& eta) -> bool {
-    printDebug("<- PickEvent::passHltWithPtEta ->");
+    PRINT_DEBUG("<- PickEvent::passHltWithPtEta ->");
+    if (!hasTrigIds_) setTrigIds(*skimT);
 
     bool isPassedHlt = false;
     if (channel_ == GlobalFlag::Channel::MultiJet) {
-        const auto& trigs = trigDetail_.getTrigMapRangePtEta();
-
-        // Loop over all triggers and collect those that pass
-        for (const auto& [trigName, trigRangePtEta] : trigs) {
-            const auto trigValue = static_cast<int>(skimT->getTrigValue(trigName));
-
-            if (trigValue &&
-                pt >= trigRangePtEta.ptMin &&
-                pt < trigRangePtEta.ptMax &&
-                std::abs(eta) >= trigRangePtEta.absEtaMin &&
-                std::abs(eta) < trigRangePtEta.absEtaMax) {
+        // The only trigger whose (pt, |eta|) region contains the jet must have fired
+        const int index = regionsPtEta_.find(pt, std::abs(eta));
+        if (index >= 0) {
+            const auto& trig = trigsPtEta_[index];
+            if (trig.id >= 0 && skimT->getTrigValue(trig.id)) {
                 isPassedHlt = true;
-                passedHlt_ = trigName;
-                printDebug(trigName + ", pt = " + std::to_string(pt) + 
-                           ", eta = " + std::to_string(eta) + 
-                           " : " + std::to_string(trigValue));
-                break;
+                passedHltIndex_ = index;
+                PRINT_DEBUG(trig.name + ", pt = " + std::to_string(pt) + 
+                            ", eta = " + std::to_string(eta) + " : 1");
             }
         }
     }
@@ -1,4 +1,5 @@
 #include "PickObject.h"
+#include "Logger.h"
 #include <TRandom.h>
 
 // Constructor implementation
@@ -8,10 +9,66 @@ PickObject::PickObject(GlobalFlag& globalFlags) :
     channel_(globalFlags_.getChannel()),
     isDebug_(globalFlags_.isDebug())
 {
+    // Muons
+    double ptThresholdMu = 20.f;
+    double etaThresholdMu = 2.3;
+    if(channel_ == GlobalFlag::Channel::Wqqm){
+        etaThresholdMu = 2.4;
+        if(year_ == GlobalFlag::Year::Year2017){
+            ptThresholdMu = 29;
+        }
+        else{
+            ptThresholdMu = 26;
+        }
+    }
+    muonCuts_.cut("pt", &SkimTree::Muon_pt, ObjectCuts::Gt, ptThresholdMu)
+             .cut("eta", &SkimTree::Muon_eta, ObjectCuts::AbsLe, etaThresholdMu)
+             .cut("tightId", &SkimTree::Muon_tightId, ObjectCuts::Ne, 0)
+             .cut("relIso", &SkimTree::Muon_pfRelIso04_all, ObjectCuts::Lt, 0.15)
+             .cut("dxy", &SkimTree::Muon_dxy, ObjectCuts::Lt, 0.2)
+             .cut("dz", &SkimTree::Muon_dz, ObjectCuts::Lt, 0.5);
+
+    // Electrons
+    double ptThresholdEle = 25.f;
+    double etaThresholdEle = 2.4;
+    if(channel_ == GlobalFlag::Channel::Wqqe){
+        etaThresholdEle = 2.4;
+        if(year_ == GlobalFlag::Year::Year2016Pre ||  year_ == GlobalFlag::Year::Year2016Post){
+            ptThresholdEle = 34;
+        }
+        else{
+            ptThresholdEle = 35;
+            etaThresholdEle = 2.5;
+        }
+    }
+    // Ensure it doesn't fall within the gap; tight electron ID
+    electronCuts_.cut("ebEeGap", &ObjectCuts::electronScEta, ObjectCuts::AbsOutside, 1.4442, 1.566)
+                 .cut("eta", &SkimTree::Electron_eta, ObjectCuts::AbsLe, etaThresholdEle)
+                 .cut("pt", &SkimTree::Electron_pt, ObjectCuts::Ge, ptThresholdEle)
+                 .cut("tightId", &SkimTree::Electron_cutBased, ObjectCuts::Eq, 4);
+
+    // Photons. R9>0.94 to avoid bias wrt R9Id90 triggers and from photon conversions
+    photonCuts_.cut("pt", &SkimTree::Photon_pt, ObjectCuts::Gt, 25)
+               .cut("eta", &SkimTree::Photon_eta, ObjectCuts::AbsLt, 1.3)
+               .cut("minR9", &SkimTree::Photon_r9, ObjectCuts::Gt, 0.94)
+               .cut("maxR9", &SkimTree::Photon_r9, ObjectCuts::Lt, 1.0)
+               .cut("hoe", &SkimTree::Photon_hoe, ObjectCuts::Lt, 0.02148)
+               .cut("tightId", &SkimTree::Photon_cutBased, ObjectCuts::Eq, 3);
+
+    // Jets
+    const float ptThresholdJet = (channel_ == GlobalFlag::Channel::GamJet) ? 15.f : 12.f;
+    const float etaThresholdJet = 1.3;
+    jetCuts_.cut("pt", &SkimTree::Jet_pt, ObjectCuts::Ge, ptThresholdJet)
+            .cut("eta", &SkimTree::Jet_eta, ObjectCuts::AbsLt, etaThresholdJet);
 }
 // Destructor
 PickObject::~PickObject() {
-    // Cleanup if necessary
+    if (isDebug_) {
+        muonCuts_.print(std::cout);
+        electronCuts_.print(std::cout);
+        photonCuts_.print(std::cout);
+        jetCuts_.print(std::cout);
+    }
 }
 
 // Clear picked objects
@@ -89,111 +146,58 @@ auto PickObject::getPickedGenJetsIndex() const -> const std::vector<int>& {
 
 // Reco objects
 void PickObject::pickMuons(const SkimTree& skimT) {
-    printDebug("Starting Selection, nMuon = "+std::to_string(skimT.nMuon));
-    pickedMuons_.clear();
-    
-    double ptThreshold = 20.f;
-    double etaThreshold = 2.3;
-    if(channel_ == GlobalFlag::Channel::Wqqm){
-        etaThreshold = 2.4;
-        if(year_ == GlobalFlag::Year::Year2017){
-            ptThreshold = 29;
-        }
-        else{
-            ptThreshold = 26;
-        }
-    }
-
-    for (UInt_t m = 0; m < skimT.nMuon; ++m) {
-        double eta = skimT.Muon_eta[m];
-        double pt = skimT.Muon_pt[m];
-
-        bool passPrompt = false;
-        if (pt > ptThreshold) {
-            passPrompt = (std::abs(eta) <= etaThreshold &&
-                          skimT.Muon_tightId[m] &&
-                          skimT.Muon_pfRelIso04_all[m] < 0.15 &&
-                          skimT.Muon_dxy[m] < 0.2 &&
-                          skimT.Muon_dz[m] < 0.5);
-        }
+    PRINT_DEBUG("Starting Selection, nMuon = "+std::to_string(skimT.nMuon));
+    muonCuts_.select(skimT, pickedMuons_);
 
-        if (passPrompt) {
-            pickedMuons_.push_back(m);
-            printDebug("Muon " + std::to_string(m) + " selected: pt = " + std::to_string(pt) + ", eta = " + std::to_string(eta));
-        } else {
-            printDebug("Muon " + std::to_string(m) + " rejected: pt = " + std::to_string(pt) + ", eta = " + std::to_string(eta));
+    if (isDebug_) {
+        size_t k = 0;
+        for (UInt_t m = 0; m < skimT.nMuon; ++m) {
+            const bool selected = k < pickedMuons_.size() && pickedMuons_[k] == static_cast<int>(m);
+            if (selected) ++k;
+            printDebug("Muon " + std::to_string(m) + (selected ? " selected" : " rejected") +
+                       ": pt = " + std::to_string(skimT.Muon_pt[m]) + ", eta = " + std::to_string(skimT.Muon_eta[m]));
         }
     }
 
-    printDebug("Total Muons Selected: " + std::to_string(pickedMuons_.size()));
+    PRINT_DEBUG("Total Muons Selected: " + std::to_string(pickedMuons_.size()));
 }
 
 void PickObject::pickElectrons(const SkimTree& skimT) {
-    printDebug("Starting Selection, nElectron = "+std::to_string(skimT.nElectron));
-    pickedElectrons_.clear();
+    PRINT_DEBUG("Starting Selection, nElectron = "+std::to_string(skimT.nElectron));
+    electronCuts_.select(skimT, pickedElectrons_);
 
-    double ptThreshold = 25.f;
-    double etaThreshold = 2.4;
-    if(channel_ == GlobalFlag::Channel::Wqqe){
-        etaThreshold = 2.4;
-        if(year_ == GlobalFlag::Year::Year2016Pre ||  year_ == GlobalFlag::Year::Year2016Post){
-            ptThreshold = 34;
-        }
-        else{
-            ptThreshold = 35;
-            etaThreshold = 2.5;
-        }
-    }
-
-    for (int eleInd = 0; eleInd < skimT.nElectron; ++eleInd) {
-        double eta = skimT.Electron_eta[eleInd];
-        double absEta = std::abs(eta);
-        double SCeta = eta + skimT.Electron_deltaEtaSC[eleInd];
-        double absSCEta = std::abs(SCeta);
-        double pt = skimT.Electron_pt[eleInd];
-
-        // Ensure it doesn't fall within the gap
-        bool passEtaEBEEGap = (absSCEta < 1.4442) || (absSCEta > 1.566);
-        // Tight electron ID
-        bool passTightID = skimT.Electron_cutBased[eleInd] == 4;
-
-        bool eleSel = (passEtaEBEEGap && absEta <= etaThreshold && pt >= ptThreshold && passTightID);
-        if (eleSel) {
-            pickedElectrons_.push_back(eleInd);
-            printDebug("Electron " + std::to_string(eleInd) + " selected: pt = " + std::to_string(pt) + ", eta = " + std::to_string(eta));
-        } else {
-            printDebug("Electron " + std::to_string(eleInd) + " rejected: pt = " + std::to_string(pt) + ", eta = " + std::to_string(eta));
+    if (isDebug_) {
+        size_t k = 0;
+        for (UInt_t eleInd = 0; eleInd < skimT.nElectron; ++eleInd) {
+            const bool selected = k < pickedElectrons_.size() && pickedElectrons_[k] == static_cast<int>(eleInd);
+            if (selected) ++k;
+            printDebug("Electron " + std::to_string(eleInd) + (selected ? " selected" : " rejected") +
+                       ": pt = " + std::to_string(skimT.Electron_pt[eleInd]) +
+                       ", eta = " + std::to_string(skimT.Electron_eta[eleInd]));
         }
     }
 
-    printDebug("Total Electrons Selected: " + std::to_string(pickedElectrons_.size()));
+    PRINT_DEBUG("Total Electrons Selected: " + std::to_string(pickedElectrons_.size()));
 }
 
 // Photon selection
 void PickObject::pickPhotons(const SkimTree& skimT) {
-    printDebug("Starting Selection, nPhoton = "+std::to_string(skimT.nPhoton));
-    pickedPhotons_.clear();
+    PRINT_DEBUG("Starting Selection, nPhoton = "+std::to_string(skimT.nPhoton));
+    photonCuts_.select(skimT, pickedPhotons_);
 
-    for (int phoInd = 0; phoInd < skimT.nPhoton; ++phoInd) {
-        double pt  = skimT.Photon_pt[phoInd];
-        double absEta = std::abs(skimT.Photon_eta[phoInd]);
-        double r9  = skimT.Photon_r9[phoInd];
-        double hoe = skimT.Photon_hoe[phoInd];
-        Int_t id = skimT.Photon_cutBased[phoInd];  // Tight ID
-        // R9>0.94 to avoid bias wrt R9Id90 triggers and from photon conversions
-        if(pt > 25 && absEta < 1.3 && r9 > 0.94 && r9 < 1.0 && hoe < 0.02148 && id==3){
-            pickedPhotons_.push_back(phoInd);
+    if (isDebug_) {
+        for (UInt_t phoInd = 0; phoInd < skimT.nPhoton; ++phoInd) {
+            printDebug(
+                "Photon " + std::to_string(phoInd) + 
+                ", Id  = " + std::to_string(skimT.Photon_cutBased[phoInd]) + 
+                ", pt  = " + std::to_string(skimT.Photon_pt[phoInd]) + 
+                ", absEta  = " + std::to_string(std::abs(skimT.Photon_eta[phoInd])) + 
+                ", hoe  = " + std::to_string(skimT.Photon_hoe[phoInd]) + 
+                ", r9  = " + std::to_string(skimT.Photon_r9[phoInd])
+           );
         }
-        printDebug(
-            "Photon " + std::to_string(phoInd) + 
-            ", Id  = " + std::to_string(id) + 
-            ", pt  = " + std::to_string(pt) + 
-            ", absEta  = " + std::to_string(absEta) + 
-            ", hoe  = " + std::to_string(hoe) + 
-            ", r9  = " + std::to_string(r9)
-       );
-    }
-    printDebug("Total Photons Selected: " + std::to_string(pickedPhotons_.size()));
+    }
+    PRINT_DEBUG("Total Photons Selected: " + std::to_string(pickedPhotons_.size()));
 }
 
 // Reference object selection
@@ -215,7 +219,7 @@ void PickObject::pickRefs(const SkimTree& skimT) {
             std::abs(p4Ref.M() - 91.1876) < 20 &&
             p4Ref.Pt() > 15) {
             pickedRefs_.push_back(p4Ref);
-            printDebug("Z->ee candidate selected with mass " + std::to_string(p4Ref.M()));
+            PRINT_DEBUG("Z->ee candidate selected with mass " + std::to_string(p4Ref.M()));
         }
     }
 
@@ -235,7 +239,7 @@ void PickObject::pickRefs(const SkimTree& skimT) {
             std::abs(p4Ref.M() - 91.1876) < 20 &&
             p4Ref.Pt() > 15) {
             pickedRefs_.push_back(p4Ref);
-            printDebug("Z->mumu candidate selected with mass " + std::to_string(p4Ref.M()));
+            PRINT_DEBUG("Z->mumu candidate selected with mass " + std::to_string(p4Ref.M()));
         }
     }
 
@@ -245,15 +249,15 @@ void PickObject::pickRefs(const SkimTree& skimT) {
             TLorentzVector p4Pho;
             p4Pho.SetPtEtaPhiM(skimT.Photon_pt[idx], skimT.Photon_eta[idx], skimT.Photon_phi[idx], skimT.Photon_mass[idx]);
             pickedRefs_.push_back(p4Pho);
-            printDebug("Photon index added to references  = " + std::to_string(idx));
+            PRINT_DEBUG("Photon index added to references  = " + std::to_string(idx));
         }
     }
-    printDebug("Total Reference Objects Selected: " + std::to_string(pickedRefs_.size()));
+    PRINT_DEBUG("Total Reference Objects Selected: " + std::to_string(pickedRefs_.size()));
 }
 
 
 void PickObject::pickRefForFakeGamma(const SkimTree& skimT, const int& iJet) {
-    printDebug("\n pickRefForFakeGamma: Starting Selection");
+    PRINT_DEBUG("\n pickRefForFakeGamma: Starting Selection");
     pickedRefs_.clear();
     int iGenJet = skimT.Jet_genJetIdx[iJet];
     double offset = 1.0;
@@ -266,24 +270,22 @@ void PickObject::pickRefForFakeGamma(const SkimTree& skimT, const int& iJet) {
         p4Pho *= offset;
         pickedRefs_.push_back(p4Pho);
     }
-    printDebug("Jet index added to reference = " + std::to_string(iJet));
-    printDebug("GenJet index added to reference = " + std::to_string(iGenJet));
-    printDebug("UE offset = " + std::to_string(offset));
-    printDebug("pickRefForFakeGamma: Done.\n");
+    PRINT_DEBUG("Jet index added to reference = " + std::to_string(iJet));
+    PRINT_DEBUG("GenJet index added to reference = " + std::to_string(iGenJet));
+    PRINT_DEBUG("UE offset = " + std::to_string(offset));
+    PRINT_DEBUG("pickRefForFakeGamma: Done.\n");
 }
 
 
 void PickObject::pickJets(const SkimTree& skimT, const TLorentzVector& p4Ref) {
-    printDebug("pickJets: Starting Selection, nJet = " + std::to_string(skimT.nJet));
+    PRINT_DEBUG("pickJets: Starting Selection, nJet = " + std::to_string(skimT.nJet));
 
     pickedJetsIndex_.clear();
     pickedJetsP4_.clear();
 
     //-----------------------------------------
-    // 1) Decide on pT threshold based on channel
+    // 1) pT threshold based on channel: jetCuts_
     //-----------------------------------------
-    float ptThreshold = (channel_ == GlobalFlag::Channel::GamJet) ? 15.f : 12.f;
-    float etaThreshold = 1.3;
 
     //-----------------------------------------
     // 2) Identify the photon->jet index if needed
@@ -292,7 +294,7 @@ void PickObject::pickJets(const SkimTree& skimT, const TLorentzVector& p4Ref) {
     if (channel_ == GlobalFlag::Channel::GamJet && !pickedPhotons_.empty()) {
         int phoInd   = pickedPhotons_.at(0);
         phoJetIdx    = skimT.Photon_jetIdx[phoInd];
-        printDebug("GamJet channel: photon->jet index = " + std::to_string(phoJetIdx));
+        PRINT_DEBUG("GamJet channel: photon->jet index = " + std::to_string(phoJetIdx));
     }
 
     //-----------------------------------------
@@ -300,24 +302,15 @@ void PickObject::pickJets(const SkimTree& skimT, const TLorentzVector& p4Ref) {
     //    (pass minimal pT, skip photon jet if GamJet)
     //-----------------------------------------
     std::vector<int> candIndices;
-    candIndices.reserve(skimT.nJet);
-
-    for (int i = 0; i < skimT.nJet; ++i) {
-        float pt = skimT.Jet_pt[i];
-        if (pt < ptThreshold) {
-            continue; 
+    jetCuts_.select(skimT, candIndices);
+
+    // Skip photon jet index in GamJet channel
+    if (channel_ == GlobalFlag::Channel::GamJet) {
+        auto it = std::find(candIndices.begin(), candIndices.end(), phoJetIdx);
+        if (it != candIndices.end()) {
+            PRINT_DEBUG("Skipping jet " + std::to_string(phoJetIdx) + " because it matches photon->jet index");
+            candIndices.erase(it);
         }
-        if (std::abs(skimT.Jet_eta[i]) >= etaThreshold) {
-            continue; 
-        }
-
-        // Skip photon jet index in GamJet channel
-        if (channel_ == GlobalFlag::Channel::GamJet && (i == phoJetIdx)) {
-            printDebug("Skipping jet " + std::to_string(i) + " because it matches photon->jet index");
-            continue;
-        }
-
-        candIndices.push_back(i);
     }
 
     //-----------------------------------------
@@ -343,23 +336,23 @@ void PickObject::pickJets(const SkimTree& skimT, const TLorentzVector& p4Ref) {
         iJet2 = candIndices[1];
     }
 
-    printDebug("After picking top-2 pT jets: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After picking top-2 pT jets: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
 
     //-----------------------------------------
     // 6) Apply Jet ID (TightLepVeto >= 6)
     //-----------------------------------------
     if (iJet1 != -1 && skimT.Jet_jetId[iJet1] < 6) {
-        printDebug("iJet1 = " + std::to_string(iJet1) + " fails JetID check -> reset to -1");
+        PRINT_DEBUG("iJet1 = " + std::to_string(iJet1) + " fails JetID check -> reset to -1");
         iJet1 = -1;
     }
     if (iJet2 != -1 && skimT.Jet_jetId[iJet2] < 6) {
-        printDebug("iJet2 = " + std::to_string(iJet2) + " fails JetID check -> reset to -1");
+        PRINT_DEBUG("iJet2 = " + std::to_string(iJet2) + " fails JetID check -> reset to -1");
         iJet2 = -1;
     }
 
-    printDebug("After JetID check: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After JetID check: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
 
     //-----------------------------------------
     // 7) Check \deltaR with reference object
@@ -378,16 +371,16 @@ void PickObject::pickJets(const SkimTree& skimT, const TLorentzVector& p4Ref) {
     };
 
     if (iJet1 != -1 && !passDeltaR(iJet1)) {
-        printDebug("iJet1 = " + std::to_string(iJet1) + " fails dR check -> reset to -1");
+        PRINT_DEBUG("iJet1 = " + std::to_string(iJet1) + " fails dR check -> reset to -1");
         iJet1 = -1;
     }
     if (iJet2 != -1 && !passDeltaR(iJet2)) {
-        printDebug("iJet2 = " + std::to_string(iJet2) + " fails dR check -> reset to -1");
+        PRINT_DEBUG("iJet2 = " + std::to_string(iJet2) + " fails dR check -> reset to -1");
         iJet2 = -1;
     }
 
-    printDebug("After dR check: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After dR check: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
 
     //-----------------------------------------
     // 8) Store the final picked jet indices
@@ -430,14 +423,14 @@ void PickObject::pickJets(const SkimTree& skimT, const TLorentzVector& p4Ref) {
     //-----------------------------------------
     // 10) Final debug info
     //-----------------------------------------
-    printDebug("Final Jets: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
-    printDebug("pickJets: Done.");
+    PRINT_DEBUG("Final Jets: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("pickJets: Done.");
 }
 
 
 void PickObject::pickJetsForFakeGamma(const SkimTree& skimT) {
-    printDebug("pickJetsForFakeGamma: Starting Selection, nJet = " + std::to_string(skimT.nJet));
+    PRINT_DEBUG("pickJetsForFakeGamma: Starting Selection, nJet = " + std::to_string(skimT.nJet));
 
     pickedJetsIndex_.clear();
     pickedJetsP4_.clear();
@@ -493,27 +486,27 @@ void PickObject::pickJetsForFakeGamma(const SkimTree& skimT) {
         iJet3 = candIndices[2];
     }
 
-    printDebug("After picking top-3 pT jets: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2) +  ", iJet3 = " + std::to_string(iJet3));
+    PRINT_DEBUG("After picking top-3 pT jets: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2) +  ", iJet3 = " + std::to_string(iJet3));
 
     //-----------------------------------------
     // 5) Apply Jet ID (TightLepVeto >= 6)
     //-----------------------------------------
     if (iJet1 != -1 && skimT.Jet_jetId[iJet1] < 6) {
-        printDebug("iJet1 = " + std::to_string(iJet1) + " fails JetID check -> reset to -1");
+        PRINT_DEBUG("iJet1 = " + std::to_string(iJet1) + " fails JetID check -> reset to -1");
         iJet1 = -1;
     }
     if (iJet2 != -1 && skimT.Jet_jetId[iJet2] < 6) {
-        printDebug("iJet2 = " + std::to_string(iJet2) + " fails JetID check -> reset to -1");
+        PRINT_DEBUG("iJet2 = " + std::to_string(iJet2) + " fails JetID check -> reset to -1");
         iJet2 = -1;
     }
     if (iJet3 != -1 && skimT.Jet_jetId[iJet3] < 6) {
-        printDebug("iJet3 = " + std::to_string(iJet3) + " fails JetID check -> reset to -1");
+        PRINT_DEBUG("iJet3 = " + std::to_string(iJet3) + " fails JetID check -> reset to -1");
         iJet3 = -1;
     }
 
-    printDebug("After JetID check: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2) +  ", iJet3 = " + std::to_string(iJet3));
+    PRINT_DEBUG("After JetID check: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2) +  ", iJet3 = " + std::to_string(iJet3));
 
     //-----------------------------------------
     // 6) Store the final picked jet indices
@@ -562,47 +555,47 @@ void PickObject::pickJetsForFakeGamma(const SkimTree& skimT) {
     //-----------------------------------------
     // 10) Final debug info
     //-----------------------------------------
-    printDebug("Final Jets: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2) +  ", iJet3 = " + std::to_string(iJet3));
-    printDebug("pickJetsForFakeGamma: Done.");
+    PRINT_DEBUG("Final Jets: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2) +  ", iJet3 = " + std::to_string(iJet3));
+    PRINT_DEBUG("pickJetsForFakeGamma: Done.");
 }
 
 // Gen objects
 void PickObject::pickGenMuons(const SkimTree& skimT) {
-    printDebug("Starting Selection, nGenDressedLepton = "+std::to_string(skimT.nGenDressedLepton));
+    PRINT_DEBUG("Starting Selection, nGenDressedLepton = "+std::to_string(skimT.nGenDressedLepton));
 
     for (int i = 0; i < skimT.nGenDressedLepton; ++i) {
         if (std::abs(skimT.GenDressedLepton_pdgId[i]) == 13) {
             pickedGenMuons_.push_back(i);
-            printDebug("Gen Muon " + std::to_string(i) + " selected");
+            PRINT_DEBUG("Gen Muon " + std::to_string(i) + " selected");
         }
     }
 
-    printDebug("Total Gen Muons Selected: " + std::to_string(pickedGenMuons_.size()));
+    PRINT_DEBUG("Total Gen Muons Selected: " + std::to_string(pickedGenMuons_.size()));
 }
 
 void PickObject::pickGenElectrons(const SkimTree& skimT) {
-    printDebug("Starting Selection, nGenDressedLepton = "+std::to_string(skimT.nGenDressedLepton));
+    PRINT_DEBUG("Starting Selection, nGenDressedLepton = "+std::to_string(skimT.nGenDressedLepton));
 
     for (int i = 0; i < skimT.nGenDressedLepton; ++i) {
         if (std::abs(skimT.GenDressedLepton_pdgId[i]) == 11) {
             pickedGenElectrons_.push_back(i);
-            printDebug("Gen Electron " + std::to_string(i) + " selected");
+            PRINT_DEBUG("Gen Electron " + std::to_string(i) + " selected");
         }
     }
 
-    printDebug("Total Gen Electrons Selected: " + std::to_string(pickedGenElectrons_.size()));
+    PRINT_DEBUG("Total Gen Electrons Selected: " + std::to_string(pickedGenElectrons_.size()));
 }
 
 void PickObject::pickGenPhotons(const SkimTree& skimT) {
-    printDebug("Starting Selection, nGenIsolatedPhoton = "+std::to_string(skimT.nGenIsolatedPhoton));
+    PRINT_DEBUG("Starting Selection, nGenIsolatedPhoton = "+std::to_string(skimT.nGenIsolatedPhoton));
 
     for (int i = 0; i < skimT.nGenIsolatedPhoton; ++i) {
         pickedGenPhotons_.push_back(i);
-        printDebug("Gen Photon " + std::to_string(i) + " selected");
+        PRINT_DEBUG("Gen Photon " + std::to_string(i) + " selected");
     }
 
-    printDebug("Total Gen Photons Selected: " + std::to_string(pickedGenPhotons_.size()));
+    PRINT_DEBUG("Total Gen Photons Selected: " + std::to_string(pickedGenPhotons_.size()));
 }
 
 void PickObject::pickGenRefs(const SkimTree& skimT, const TLorentzVector& p4Ref) {
@@ -627,7 +620,7 @@ void PickObject::pickGenRefs(const SkimTree& skimT, const TLorentzVector& p4Ref)
                 TLorentzVector p4GenRef = p4Lep1 + p4Lep2;
                 if(p4GenRef.DeltaR(p4Ref) > 0.2) continue;
                 pickedGenRefs_.push_back(p4GenRef);
-                printDebug("Gen Z->ee candidate selected with mass " + std::to_string(p4GenRef.M()));
+                PRINT_DEBUG("Gen Z->ee candidate selected with mass " + std::to_string(p4GenRef.M()));
             }
         }
     }
@@ -653,7 +646,7 @@ void PickObject::pickGenRefs(const SkimTree& skimT, const TLorentzVector& p4Ref)
                 TLorentzVector p4GenRef = p4Lep1 + p4Lep2;
                 if(p4GenRef.DeltaR(p4Ref) > 0.2) continue;
                 pickedGenRefs_.push_back(p4GenRef);
-                printDebug("Gen Z->mumu candidate selected with mass " + std::to_string(p4GenRef.M()));
+                PRINT_DEBUG("Gen Z->mumu candidate selected with mass " + std::to_string(p4GenRef.M()));
             }
         }
     }
@@ -668,15 +661,15 @@ void PickObject::pickGenRefs(const SkimTree& skimT, const TLorentzVector& p4Ref)
                                   skimT.GenIsolatedPhoton_mass[idx]);
             if(p4GenRef.DeltaR(p4Ref) > 0.2) continue;
             pickedGenRefs_.push_back(p4GenRef);
-            printDebug("Gen Photon added to references: pt = " + std::to_string(skimT.GenIsolatedPhoton_pt[idx]));
+            PRINT_DEBUG("Gen Photon added to references: pt = " + std::to_string(skimT.GenIsolatedPhoton_pt[idx]));
         }
     }
 
-    printDebug("Total Gen Reference Objects Selected: " + std::to_string(pickedGenRefs_.size()));
+    PRINT_DEBUG("Total Gen Reference Objects Selected: " + std::to_string(pickedGenRefs_.size()));
 }
 
 void PickObject::pickGenJets(const SkimTree& skimT, const int& iJet1, const int& iJet2, const TLorentzVector& p4Jet1, const TLorentzVector& p4Jet2) {
-    printDebug("pickGenJets: Starting Selection, nJet = " + std::to_string(skimT.nJet));
+    PRINT_DEBUG("pickGenJets: Starting Selection, nJet = " + std::to_string(skimT.nJet));
 
     pickedGenJetsIndex_.clear();
     pickedGenJetsP4_.clear();
@@ -705,6 +698,6 @@ void PickObject::pickGenJets(const SkimTree& skimT, const int& iJet1, const int&
     pickedGenJetsP4_.push_back(p4GenJet2);
 
     // debug info
-    printDebug("Final Jets: iJet1 = " + std::to_string(iGenJet1) +
-               ", iJet2 = " + std::to_string(iGenJet2));
+    PRINT_DEBUG("Final Jets: iJet1 = " + std::to_string(iGenJet1) +
+                ", iJet2 = " + std::to_string(iGenJet2));
 }
@@ -1,4 +1,5 @@
 #include "PickObjectGamJet.h"
+#include "Logger.h"
 #include "ReadConfig.h"
 
 // Constructor implementation
@@ -13,7 +14,10 @@ PickObjectGamJet::PickObjectGamJet(GlobalFlag& globalFlags) :
 
 // Destructor
 PickObjectGamJet::~PickObjectGamJet() {
-    // Cleanup if necessary
+    if (isDebug_) {
+        photonCuts_.print(std::cout);
+        jetCuts_.print(std::cout);
+    }
 }
 
 // Load configuration from JSON file and store values in private members
@@ -27,12 +31,20 @@ void PickObjectGamJet::loadConfig(const std::string& filename) {
     minR9Pho_       = config.getValue<double>({"photonPick", "minR9"});
     maxR9Pho_       = config.getValue<double>({"photonPick", "maxR9"});
     maxHoePho_      = config.getValue<double>({"photonPick", "maxHoe"});
+    // minR9 to avoid bias wrt R9Id90 triggers and from photon conversions
+    photonCuts_.cut("pt", &SkimTree::Photon_pt, ObjectCuts::Gt, minPtPho_)
+               .cut("eta", &SkimTree::Photon_eta, ObjectCuts::AbsLt, maxEtaPho_)
+               .cut("minR9", &SkimTree::Photon_r9, ObjectCuts::Gt, minR9Pho_)
+               .cut("maxR9", &SkimTree::Photon_r9, ObjectCuts::Lt, maxR9Pho_)
+               .cut("hoe", &SkimTree::Photon_hoe, ObjectCuts::Lt, maxHoePho_)
+               .cut("tightId", &SkimTree::Photon_cutBased, ObjectCuts::Eq, tightIdPho_);
 
     // Jet pick configuration
     minPtJet_           = config.getValue<double>({"jetPick", "minPt"});
     maxEtaLeadingJet_   = config.getValue<double>({"jetPick", "maxEtaLeading"});
     minIdJet_           = config.getValue<int>({"jetPick", "minId"});
     minDeltaRrefJet_    = config.getValue<double>({"jetPick", "minDeltaR"});
+    jetCuts_.cut("pt", &SkimTree::Jet_pt, ObjectCuts::Ge, minPtJet_);
 
     // Gen Photon pick configuration
     pdgIdGenPho_ = config.getValue<int>({"genPhotonPick", "pdgId"});
@@ -53,29 +65,22 @@ void PickObjectGamJet::printDebug(const std::string& message) const {
 
 // Photon selection
 void PickObjectGamJet::pickPhotons(const SkimTree& skimT) {
-    printDebug("Starting Selection, nPhoton = "+std::to_string(skimT.nPhoton));
-    pickedPhotons_.clear();
-
-    for (int phoInd = 0; phoInd < skimT.nPhoton; ++phoInd) {
-        double pt  = skimT.Photon_pt[phoInd];
-        double absEta = std::abs(skimT.Photon_eta[phoInd]);
-        double r9  = skimT.Photon_r9[phoInd];
-        double hoe = skimT.Photon_hoe[phoInd];
-        Int_t id = skimT.Photon_cutBased[phoInd];  // Tight ID
-        // minR9 to avoid bias wrt R9Id90 triggers and from photon conversions
-        if(pt > minPtPho_ && absEta < maxEtaPho_ && r9 > minR9Pho_ && r9 < maxR9Pho_ && hoe < maxHoePho_ && id==tightIdPho_){
-            pickedPhotons_.push_back(phoInd);
+    PRINT_DEBUG("Starting Selection, nPhoton = "+std::to_string(skimT.nPhoton));
+    photonCuts_.select(skimT, pickedPhotons_);
+
+    if (isDebug_) {
+        for (UInt_t phoInd = 0; phoInd < skimT.nPhoton; ++phoInd) {
+            printDebug(
+                "Photon " + std::to_string(phoInd) + 
+                ", Id  = " + std::to_string(skimT.Photon_cutBased[phoInd]) + 
+                ", pt  = " + std::to_string(skimT.Photon_pt[phoInd]) + 
+                ", absEta  = " + std::to_string(std::abs(skimT.Photon_eta[phoInd])) + 
+                ", hoe  = " + std::to_string(skimT.Photon_hoe[phoInd]) + 
+                ", r9  = " + std::to_string(skimT.Photon_r9[phoInd])
+           );
         }
-        printDebug(
-            "Photon " + std::to_string(phoInd) + 
-            ", Id  = " + std::to_string(id) + 
-            ", pt  = " + std::to_string(pt) + 
-            ", absEta  = " + std::to_string(absEta) + 
-            ", hoe  = " + std::to_string(hoe) + 
-            ", r9  = " + std::to_string(r9)
-       );
     }
-    printDebug("Total Photons Selected: " + std::to_string(pickedPhotons_.size()));
+    PRINT_DEBUG("Total Photons Selected: " + std::to_string(pickedPhotons_.size()));
 }
 
 // Reference object picking (e.g., for Z->ee)
@@ -85,21 +90,21 @@ void PickObjectGamJet::pickRefs(const SkimTree& skimT) {
         TLorentzVector p4Pho;
         p4Pho.SetPtEtaPhiM(skimT.Photon_pt[idx], skimT.Photon_eta[idx], skimT.Photon_phi[idx], skimT.Photon_mass[idx]);
         pickedRefs_.push_back(p4Pho);
-        printDebug("Photon index added to references  = " + std::to_string(idx));
+        PRINT_DEBUG("Photon index added to references  = " + std::to_string(idx));
     }
-    printDebug("Total Reference Objects Selected: " + std::to_string(pickedRefs_.size()));
+    PRINT_DEBUG("Total Reference Objects Selected: " + std::to_string(pickedRefs_.size()));
 }
 
 
 void PickObjectGamJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4Ref) {
-    printDebug("pickJets: Starting, nJet = " + std::to_string(skimT.nJet));
+    PRINT_DEBUG("pickJets: Starting, nJet = " + std::to_string(skimT.nJet));
 
     pickedJetsIndex_.clear();
     pickedJetsP4_.clear();
 
     // Gather candidate jet indices based on minimum Pt and maximum Eta from config.
     std::vector<int> candIndices;
-    candIndices.reserve(skimT.nJet);
+    jetCuts_.select(skimT, candIndices);
 
     //-----------------------------------------
     // Identify the photon->jet index if needed
@@ -108,14 +113,9 @@ void PickObjectGamJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4R
     if (!pickedPhotons_.empty()) {
         int phoInd   = pickedPhotons_.at(0);
         phoJetIdx    = skimT.Photon_jetIdx[phoInd];
-        printDebug("GamJet channel: photon->jet index = " + std::to_string(phoJetIdx));
-    }
-    for (int i = 0; i < skimT.nJet; ++i) {
-        float pt = skimT.Jet_pt[i];
-        if (pt < minPtJet_) continue;
-        if(i == phoJetIdx) continue;
-        candIndices.push_back(i);
+        PRINT_DEBUG("GamJet channel: photon->jet index = " + std::to_string(phoJetIdx));
     }
+    candIndices.erase(std::remove(candIndices.begin(), candIndices.end(), phoJetIdx), candIndices.end());
 
     // Sort candidate jets by Pt (descending)
     std::sort(candIndices.begin(), candIndices.end(),
@@ -132,24 +132,24 @@ void PickObjectGamJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4R
         iJet2 = candIndices[1];
     }
 
-    printDebug("After picking top-2 Pt jets: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After picking top-2 Pt jets: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
 
     // Apply Jet ID criteria from config on leading jet
     if (iJet1 != -1 && skimT.Jet_jetId[iJet1] < minIdJet_) {
-        printDebug("iJet1 = " + std::to_string(iJet1) + " fails Jet ID check -> reset to -1");
+        PRINT_DEBUG("iJet1 = " + std::to_string(iJet1) + " fails Jet ID check -> reset to -1");
         iJet1 = -1;
     }
-    printDebug("After Jet ID check on ONLY iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After Jet ID check on ONLY iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
 
     // Apply eta criteria from config on leading jet
     if (iJet1 != -1 && std::abs(skimT.Jet_eta[iJet1]) > maxEtaLeadingJet_) {
-        printDebug("iJet1 = " + std::to_string(iJet1) + " fails eta check -> reset to -1");
+        PRINT_DEBUG("iJet1 = " + std::to_string(iJet1) + " fails eta check -> reset to -1");
         iJet1 = -1;
     }
-    printDebug("After eta check on ONLY iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After eta check on ONLY iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
     
     //-----------------------------------------
     //    Check \deltaR with reference object
@@ -168,16 +168,16 @@ void PickObjectGamJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4R
     };
 
     if (iJet1 != -1 && !passDeltaR(iJet1)) {
-        printDebug("iJet1 = " + std::to_string(iJet1) + " fails dR check -> reset to -1");
+        PRINT_DEBUG("iJet1 = " + std::to_string(iJet1) + " fails dR check -> reset to -1");
         iJet1 = -1;
     }
     if (iJet2 != -1 && !passDeltaR(iJet2)) {
-        printDebug("iJet2 = " + std::to_string(iJet2) + " fails dR check -> reset to -1");
+        PRINT_DEBUG("iJet2 = " + std::to_string(iJet2) + " fails dR check -> reset to -1");
         iJet2 = -1;
     }
 
-    printDebug("After dR check: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After dR check: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
 
     pickedJetsIndex_.push_back(iJet1);
     pickedJetsIndex_.push_back(iJet2);
@@ -206,22 +206,22 @@ void PickObjectGamJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4R
     pickedJetsP4_.push_back(p4Jet2Vec);
     pickedJetsP4_.push_back(p4JetN);
 
-    printDebug("Final Jets: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
-    printDebug("pickJets: Done.");
+    PRINT_DEBUG("Final Jets: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("pickJets: Done.");
 }
 
 
 void PickObjectGamJet::pickGenPhotons(const SkimTree& skimT) {
-    printDebug("Starting Selection, nGenIsolatedPhoton = "+std::to_string(skimT.nGenIsolatedPhoton));
+    PRINT_DEBUG("Starting Selection, nGenIsolatedPhoton = "+std::to_string(skimT.nGenIsolatedPhoton));
     pickedGenPhotons_.clear();
 
     for (int i = 0; i < skimT.nGenIsolatedPhoton; ++i) {
         pickedGenPhotons_.push_back(i);
-        printDebug("Gen Photon " + std::to_string(i) + " selected");
+        PRINT_DEBUG("Gen Photon " + std::to_string(i) + " selected");
     }
 
-    printDebug("Total Gen Photons Selected: " + std::to_string(pickedGenPhotons_.size()));
+    PRINT_DEBUG("Total Gen Photons Selected: " + std::to_string(pickedGenPhotons_.size()));
 }
 
 void PickObjectGamJet::pickGenRefs(const SkimTree& skimT, const TLorentzVector& p4Ref) {
@@ -235,16 +235,16 @@ void PickObjectGamJet::pickGenRefs(const SkimTree& skimT, const TLorentzVector&
                                   skimT.GenIsolatedPhoton_mass[idx]);
             if(p4GenRef.DeltaR(p4Ref) > maxDeltaRgenRef_) continue;
             pickedGenRefs_.push_back(p4GenRef);
-            printDebug("Gen Photon added to references: pt = " + std::to_string(skimT.GenIsolatedPhoton_pt[idx]));
+            PRINT_DEBUG("Gen Photon added to references: pt = " + std::to_string(skimT.GenIsolatedPhoton_pt[idx]));
         }
     }
 
-    printDebug("Total Gen Reference Objects Picked: " + std::to_string(pickedGenRefs_.size()));
+    PRINT_DEBUG("Total Gen Reference Objects Picked: " + std::to_string(pickedGenRefs_.size()));
 }
 
 void PickObjectGamJet::pickGenJets(const SkimTree& skimT, const int& iJet1, const int& iJet2,
                              const TLorentzVector& p4Jet1, const TLorentzVector& p4Jet2) {
-    printDebug("pickGenJets: Starting, nJet = " + std::to_string(skimT.nGenJet));
+    PRINT_DEBUG("pickGenJets: Starting, nJet = " + std::to_string(skimT.nGenJet));
 
     pickedGenJetsIndex_.clear();
     pickedGenJetsP4_.clear();
@@ -269,7 +269,7 @@ void PickObjectGamJet::pickGenJets(const SkimTree& skimT, const int& iJet1, cons
     pickedGenJetsP4_.push_back(p4GenJet1);
     pickedGenJetsP4_.push_back(p4GenJet2);
 
-    printDebug("Final Gen Jets: iGenJet1 = " + std::to_string(iGenJet1) +
-               ", iGenJet2 = " + std::to_string(iGenJet2));
+    PRINT_DEBUG("Final Gen Jets: iGenJet1 = " + std::to_string(iGenJet1) +
+                ", iGenJet2 = " + std::to_string(iGenJet2));
 }
 
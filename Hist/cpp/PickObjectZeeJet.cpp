@@ -1,4 +1,5 @@
 #include "PickObjectZeeJet.h"
+#include "Logger.h"
 #include "ReadConfig.h"
 
 // Constructor implementation
@@ -13,7 +14,10 @@ PickObjectZeeJet::PickObjectZeeJet(GlobalFlag& globalFlags) :
 
 // Destructor
 PickObjectZeeJet::~PickObjectZeeJet() {
-    // Cleanup if necessary
+    if (isDebug_) {
+        electronCuts_.print(std::cout);
+        jetCuts_.print(std::cout);
+    }
 }
 
 // Load configuration from JSON file and store values in private members
@@ -26,6 +30,11 @@ void PickObjectZeeJet::loadConfig(const std::string& filename) {
     tightIdEle_     = config.getValue<int>({"electronPick", "tightId"});
     minEbEeGap_     = config.getValue<double>({"electronPick", "ebEeGap", "min"});
     maxEbEeGap_     = config.getValue<double>({"electronPick", "ebEeGap", "max"});
+    // Supercluster outside the barrel-endcap gap; tight electron ID
+    electronCuts_.cut("ebEeGap", &ObjectCuts::electronScEta, ObjectCuts::AbsOutside, minEbEeGap_, maxEbEeGap_)
+                 .cut("eta", &SkimTree::Electron_eta, ObjectCuts::AbsLe, maxEtaEle_)
+                 .cut("pt", &SkimTree::Electron_pt, ObjectCuts::Ge, minPtEle_)
+                 .cut("tightId", &SkimTree::Electron_cutBased, ObjectCuts::Eq, tightIdEle_);
 
     // Reference pick configuration
     massRef_        = config.getValue<double>({"referencePick", "mass"});
@@ -38,6 +47,9 @@ void PickObjectZeeJet::loadConfig(const std::string& filename) {
     Jet_electronIdx1_   = config.getValue<int>({"jetPick", "Jet_electronIdx1"});
     Jet_electronIdx2_   = config.getValue<int>({"jetPick", "Jet_electronIdx2"});
     minIdJet_           = config.getValue<int>({"jetPick", "minId"});
+    jetCuts_.cut("pt", &SkimTree::Jet_pt, ObjectCuts::Ge, minPtJet_)
+            .cut("electronIdx1", &SkimTree::Jet_electronIdx1, ObjectCuts::Eq, Jet_electronIdx1_)
+            .cut("electronIdx2", &SkimTree::Jet_electronIdx2, ObjectCuts::Eq, Jet_electronIdx2_);
 
     // Gen Electron pick configuration
     pdgIdGenEle_ = config.getValue<int>({"genElectronPick", "pdgId"});
@@ -57,33 +69,21 @@ void PickObjectZeeJet::printDebug(const std::string& message) const {
 }
 
 void PickObjectZeeJet::pickElectrons(const SkimTree& skimT) {
-    printDebug("Starting pickElectrons, nElectron = " + std::to_string(skimT.nElectron));
-    pickedElectrons_.clear();
-
-    for (int eleInd = 0; eleInd < skimT.nElectron; ++eleInd) {
-        double eta = skimT.Electron_eta[eleInd];
-        double absEta = std::abs(eta);
-        double SCeta = eta + skimT.Electron_deltaEtaSC[eleInd];
-        double absSCEta = std::abs(SCeta);
-        double pt = skimT.Electron_pt[eleInd];
-
-        // Check that the supercluster does not fall within the barrel-endcap gap.
-        bool passEtaEBEEGap = (absSCEta < minEbEeGap_) || (absSCEta > maxEbEeGap_);
-        // Tight electron ID check
-        bool passTightID = (skimT.Electron_cutBased[eleInd] == tightIdEle_);
-
-        bool eleSel = (passEtaEBEEGap && absEta <= maxEtaEle_ && pt >= minPtEle_ && passTightID);
-        if (eleSel) {
-            pickedElectrons_.push_back(eleInd);
-            printDebug("Electron " + std::to_string(eleInd) + " selected: pt = " +
-                       std::to_string(pt) + ", eta = " + std::to_string(eta));
-        } else {
-            printDebug("Electron " + std::to_string(eleInd) + " rejected: pt = " +
-                       std::to_string(pt) + ", eta = " + std::to_string(eta));
+    PRINT_DEBUG("Starting pickElectrons, nElectron = " + std::to_string(skimT.nElectron));
+    electronCuts_.select(skimT, pickedElectrons_);
+
+    if (isDebug_) {
+        size_t k = 0;
+        for (UInt_t eleInd = 0; eleInd < skimT.nElectron; ++eleInd) {
+            const bool selected = k < pickedElectrons_.size() && pickedElectrons_[k] == static_cast<int>(eleInd);
+            if (selected) ++k;
+            printDebug("Electron " + std::to_string(eleInd) + (selected ? " selected" : " rejected") +
+                       ": pt = " + std::to_string(skimT.Electron_pt[eleInd]) +
+                       ", eta = " + std::to_string(skimT.Electron_eta[eleInd]));
         }
     }
 
-    printDebug("Total Electrons Picked: " + std::to_string(pickedElectrons_.size()));
+    PRINT_DEBUG("Total Electrons Picked: " + std::to_string(pickedElectrons_.size()));
 }
 
 // Reference object picking (e.g., for Z->ee)
@@ -104,31 +104,23 @@ void PickObjectZeeJet::pickRefs(const SkimTree& skimT) {
             std::abs(p4Ref.M() - massRef_) < massWindowRef_ &&
             p4Ref.Pt() > minPtRef_) {
             pickedRefs_.push_back(p4Ref);
-            printDebug("Z->ee candidate picked with mass " + std::to_string(p4Ref.M()));
+            PRINT_DEBUG("Z->ee candidate picked with mass " + std::to_string(p4Ref.M()));
         }
     }
 
-    printDebug("Total Reference Objects Picked: " + std::to_string(pickedRefs_.size()));
+    PRINT_DEBUG("Total Reference Objects Picked: " + std::to_string(pickedRefs_.size()));
 }
 
 
 void PickObjectZeeJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4Ref) {
-    printDebug("pickJets: Starting, nJet = " + std::to_string(skimT.nJet));
+    PRINT_DEBUG("pickJets: Starting, nJet = " + std::to_string(skimT.nJet));
 
     pickedJetsIndex_.clear();
     pickedJetsP4_.clear();
 
     // Gather candidate jet indices based on minimum Pt and maximum Eta from config.
     std::vector<int> candIndices;
-    candIndices.reserve(skimT.nJet);
-
-    for (int i = 0; i < skimT.nJet; ++i) {
-        float pt = skimT.Jet_pt[i];
-        if (pt < minPtJet_) continue;
-        if(skimT.Jet_electronIdx1[i] != Jet_electronIdx1_) continue;
-        if(skimT.Jet_electronIdx2[i] != Jet_electronIdx2_) continue;
-        candIndices.push_back(i);
-    }
+    jetCuts_.select(skimT, candIndices);
 
     // Sort candidate jets by Pt (descending)
     std::sort(candIndices.begin(), candIndices.end(),
@@ -145,24 +137,24 @@ void PickObjectZeeJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4R
         iJet2 = candIndices[1];
     }
 
-    printDebug("After picking top-2 Pt jets: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After picking top-2 Pt jets: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
 
     // Apply Jet ID criteria from config on leading jet
     if (iJet1 != -1 && skimT.Jet_jetId[iJet1] < minIdJet_) {
-        printDebug("iJet1 = " + std::to_string(iJet1) + " fails Jet ID check -> reset to -1");
+        PRINT_DEBUG("iJet1 = " + std::to_string(iJet1) + " fails Jet ID check -> reset to -1");
         iJet1 = -1;
     }
-    printDebug("After Jet ID check on ONLY iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After Jet ID check on ONLY iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
 
     // Apply eta criteria from config on leading jet
     if (iJet1 != -1 && std::abs(skimT.Jet_eta[iJet1]) > maxEtaLeadingJet_) {
-        printDebug("iJet1 = " + std::to_string(iJet1) + " fails eta check -> reset to -1");
+        PRINT_DEBUG("iJet1 = " + std::to_string(iJet1) + " fails eta check -> reset to -1");
         iJet1 = -1;
     }
-    printDebug("After eta check on ONLY iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After eta check on ONLY iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
     pickedJetsIndex_.push_back(iJet1);
     pickedJetsIndex_.push_back(iJet2);
 
@@ -190,24 +182,24 @@ void PickObjectZeeJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4R
     pickedJetsP4_.push_back(p4Jet2Vec);
     pickedJetsP4_.push_back(p4JetN);
 
-    printDebug("Final Jets: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
-    printDebug("pickJets: Done.");
+    PRINT_DEBUG("Final Jets: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("pickJets: Done.");
 }
 
 
 void PickObjectZeeJet::pickGenElectrons(const SkimTree& skimT) {
     pickedGenElectrons_.clear();
-    printDebug("Starting pickGenElectrons, nGenDressedLepton = " + std::to_string(skimT.nGenDressedLepton));
+    PRINT_DEBUG("Starting pickGenElectrons, nGenDressedLepton = " + std::to_string(skimT.nGenDressedLepton));
 
     for (int i = 0; i < skimT.nGenDressedLepton; ++i) {
         if (std::abs(skimT.GenDressedLepton_pdgId[i]) == pdgIdGenEle_) {
             pickedGenElectrons_.push_back(i);
-            printDebug("Gen Electron " + std::to_string(i) + " picked");
+            PRINT_DEBUG("Gen Electron " + std::to_string(i) + " picked");
         }
     }
 
-    printDebug("Total Gen Electrons Picked: " + std::to_string(pickedGenElectrons_.size()));
+    PRINT_DEBUG("Total Gen Electrons Picked: " + std::to_string(pickedGenElectrons_.size()));
 }
 
 void PickObjectZeeJet::pickGenRefs(const SkimTree& skimT, const TLorentzVector& p4Ref) {
@@ -231,17 +223,17 @@ void PickObjectZeeJet::pickGenRefs(const SkimTree& skimT, const TLorentzVector&
                 TLorentzVector p4GenRef = p4Lep1 + p4Lep2;
                 if (p4GenRef.DeltaR(p4Ref) > maxDeltaRgenRef_) continue;
                 pickedGenRefs_.push_back(p4GenRef);
-                printDebug("Gen Z->ee candidate picked with mass " + std::to_string(p4GenRef.M()));
+                PRINT_DEBUG("Gen Z->ee candidate picked with mass " + std::to_string(p4GenRef.M()));
             }
         }
     }
 
-    printDebug("Total Gen Reference Objects Picked: " + std::to_string(pickedGenRefs_.size()));
+    PRINT_DEBUG("Total Gen Reference Objects Picked: " + std::to_string(pickedGenRefs_.size()));
 }
 
 void PickObjectZeeJet::pickGenJets(const SkimTree& skimT, const int& iJet1, const int& iJet2,
                              const TLorentzVector& p4Jet1, const TLorentzVector& p4Jet2) {
-    printDebug("pickGenJets: Starting, nJet = " + std::to_string(skimT.nGenJet));
+    PRINT_DEBUG("pickGenJets: Starting, nJet = " + std::to_string(skimT.nGenJet));
 
     pickedGenJetsIndex_.clear();
     pickedGenJetsP4_.clear();
@@ -266,7 +258,7 @@ void PickObjectZeeJet::pickGenJets(const SkimTree& skimT, const int& iJet1, cons
     pickedGenJetsP4_.push_back(p4GenJet1);
     pickedGenJetsP4_.push_back(p4GenJet2);
 
-    printDebug("Final Gen Jets: iGenJet1 = " + std::to_string(iGenJet1) +
-               ", iGenJet2 = " + std::to_string(iGenJet2));
+    PRINT_DEBUG("Final Gen Jets: iGenJet1 = " + std::to_string(iGenJet1) +
+                ", iGenJet2 = " + std::to_string(iGenJet2));
 }
 
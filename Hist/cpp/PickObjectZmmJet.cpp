@@ -1,4 +1,5 @@
 #include "PickObjectZmmJet.h"
+#include "Logger.h"
 #include "ReadConfig.h"
 
 // Constructor implementation
@@ -13,7 +14,10 @@ PickObjectZmmJet::PickObjectZmmJet(GlobalFlag& globalFlags) :
 
 // Destructor
 PickObjectZmmJet::~PickObjectZmmJet() {
-    // Cleanup if necessary
+    if (isDebug_) {
+        muonCuts_.print(std::cout);
+        jetCuts_.print(std::cout);
+    }
 }
 
 // Load configuration from JSON file and store values in private members
@@ -27,6 +31,12 @@ void PickObjectZmmJet::loadConfig(const std::string& filename) {
     maxRelIsoMu_  = config.getValue<double>({"muonPick", "maxRelIso"});
     maxDxyMu_     = config.getValue<double>({"muonPick", "maxDxy"});
     maxDzMu_      = config.getValue<double>({"muonPick", "maxDz"});
+    muonCuts_.cut("eta", &SkimTree::Muon_eta, ObjectCuts::AbsLe, maxEtaMu_)
+             .cut("pt", &SkimTree::Muon_pt, ObjectCuts::Ge, minPtMu_)
+             .cut("tightId", &SkimTree::Muon_tightId, ObjectCuts::Eq, tightIdMu_)
+             .cut("relIso", &SkimTree::Muon_pfRelIso04_all, ObjectCuts::Lt, maxRelIsoMu_)
+             .cut("dxy", &SkimTree::Muon_dxy, ObjectCuts::Lt, maxDxyMu_)
+             .cut("dz", &SkimTree::Muon_dz, ObjectCuts::Lt, maxDzMu_);
 
     // Reference pick configuration
     massRef_       = config.getValue<double>({"referencePick", "mass"});
@@ -39,6 +49,9 @@ void PickObjectZmmJet::loadConfig(const std::string& filename) {
     Jet_muonIdx1_       = config.getValue<int>({"jetPick", "Jet_muonIdx1"});
     Jet_muonIdx2_       = config.getValue<int>({"jetPick", "Jet_muonIdx2"});
     minIdJet_           = config.getValue<int>({"jetPick", "minId"});
+    jetCuts_.cut("pt", &SkimTree::Jet_pt, ObjectCuts::Ge, minPtJet_)
+            .cut("muonIdx1", &SkimTree::Jet_muonIdx1, ObjectCuts::Eq, Jet_muonIdx1_)
+            .cut("muonIdx2", &SkimTree::Jet_muonIdx2, ObjectCuts::Eq, Jet_muonIdx2_);
 
     // Gen Muon pick configuration
     pdgIdGenMu_ = config.getValue<int>({"genMuonPick", "pdgId"});
@@ -58,31 +71,21 @@ void PickObjectZmmJet::printDebug(const std::string& message) const {
 }
 
 void PickObjectZmmJet::pickMuons(const SkimTree& skimT) {
-    printDebug("Starting pickMuons, nMuon = " + std::to_string(skimT.nMuon));
-    pickedMuons_.clear();
-
-    for (int muInd = 0; muInd < skimT.nMuon; ++muInd) {
-        double eta = skimT.Muon_eta[muInd];
-        double pt = skimT.Muon_pt[muInd];
-
-        bool muSel = (std::abs(eta) <= maxEtaMu_ &&
-             pt >= minPtMu_ &&
-             skimT.Muon_tightId[muInd] == tightIdMu_ &&
-             skimT.Muon_pfRelIso04_all[muInd] < maxRelIsoMu_ &&
-             skimT.Muon_dxy[muInd] < maxDxyMu_ &&
-             skimT.Muon_dz[muInd] < maxDzMu_);
-
-        if (muSel) {
-            pickedMuons_.push_back(muInd);
-            printDebug("Muon " + std::to_string(muInd) + " smucted: pt = " +
-                       std::to_string(pt) + ", eta = " + std::to_string(eta));
-        } else {
-            printDebug("Muon " + std::to_string(muInd) + " rejected: pt = " +
-                       std::to_string(pt) + ", eta = " + std::to_string(eta));
+    PRINT_DEBUG("Starting pickMuons, nMuon = " + std::to_string(skimT.nMuon));
+    muonCuts_.select(skimT, pickedMuons_);
+
+    if (isDebug_) {
+        size_t k = 0;
+        for (UInt_t muInd = 0; muInd < skimT.nMuon; ++muInd) {
+            const bool selected = k < pickedMuons_.size() && pickedMuons_[k] == static_cast<int>(muInd);
+            if (selected) ++k;
+            printDebug("Muon " + std::to_string(muInd) + (selected ? " selected" : " rejected") +
+                       ": pt = " + std::to_string(skimT.Muon_pt[muInd]) +
+                       ", eta = " + std::to_string(skimT.Muon_eta[muInd]));
         }
     }
 
-    printDebug("Total Muons Picked: " + std::to_string(pickedMuons_.size()));
+    PRINT_DEBUG("Total Muons Picked: " + std::to_string(pickedMuons_.size()));
 }
 
 // Reference object picking (e.g., for Z->ee)
@@ -103,31 +106,23 @@ void PickObjectZmmJet::pickRefs(const SkimTree& skimT) {
             std::abs(p4Ref.M() - massRef_) < massWindowRef_ &&
             p4Ref.Pt() > minPtRef_) {
             pickedRefs_.push_back(p4Ref);
-            printDebug("Z->ee candidate picked with mass " + std::to_string(p4Ref.M()));
+            PRINT_DEBUG("Z->ee candidate picked with mass " + std::to_string(p4Ref.M()));
         }
     }
 
-    printDebug("Total Reference Objects Picked: " + std::to_string(pickedRefs_.size()));
+    PRINT_DEBUG("Total Reference Objects Picked: " + std::to_string(pickedRefs_.size()));
 }
 
 
 void PickObjectZmmJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4Ref) {
-    printDebug("pickJets: Starting, nJet = " + std::to_string(skimT.nJet));
+    PRINT_DEBUG("pickJets: Starting, nJet = " + std::to_string(skimT.nJet));
 
     pickedJetsIndex_.clear();
     pickedJetsP4_.clear();
 
     // Gather candidate jet indices based on minimum Pt and maximum Eta from config.
     std::vector<int> candIndices;
-    candIndices.reserve(skimT.nJet);
-
-    for (int i = 0; i < skimT.nJet; ++i) {
-        float pt = skimT.Jet_pt[i];
-        if (pt < minPtJet_) continue;
-        if(skimT.Jet_muonIdx1[i] != Jet_muonIdx1_) continue;
-        if(skimT.Jet_muonIdx2[i] != Jet_muonIdx2_) continue;
-        candIndices.push_back(i);
-    }
+    jetCuts_.select(skimT, candIndices);
 
     // Sort candidate jets by Pt (descending)
     std::sort(candIndices.begin(), candIndices.end(),
@@ -144,24 +139,24 @@ void PickObjectZmmJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4R
         iJet2 = candIndices[1];
     }
 
-    printDebug("After picking top-2 Pt jets: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After picking top-2 Pt jets: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
 
     // Apply Jet ID criteria from config on leading jet
     if (iJet1 != -1 && skimT.Jet_jetId[iJet1] < minIdJet_) {
-        printDebug("iJet1 = " + std::to_string(iJet1) + " fails Jet ID check -> reset to -1");
+        PRINT_DEBUG("iJet1 = " + std::to_string(iJet1) + " fails Jet ID check -> reset to -1");
         iJet1 = -1;
     }
-    printDebug("After Jet ID check on ONLY iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After Jet ID check on ONLY iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
 
     // Apply eta criteria from config on leading jet
     if (iJet1 != -1 && std::abs(skimT.Jet_eta[iJet1]) > maxEtaLeadingJet_) {
-        printDebug("iJet1 = " + std::to_string(iJet1) + " fails eta check -> reset to -1");
+        PRINT_DEBUG("iJet1 = " + std::to_string(iJet1) + " fails eta check -> reset to -1");
         iJet1 = -1;
     }
-    printDebug("After eta check on ONLY iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("After eta check on ONLY iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
     pickedJetsIndex_.push_back(iJet1);
     pickedJetsIndex_.push_back(iJet2);
 
@@ -189,24 +184,24 @@ void PickObjectZmmJet::pickJets(const SkimTree& skimT, const TLorentzVector& p4R
     pickedJetsP4_.push_back(p4Jet2Vec);
     pickedJetsP4_.push_back(p4JetN);
 
-    printDebug("Final Jets: iJet1 = " + std::to_string(iJet1) +
-               ", iJet2 = " + std::to_string(iJet2));
-    printDebug("pickJets: Done.");
+    PRINT_DEBUG("Final Jets: iJet1 = " + std::to_string(iJet1) +
+                ", iJet2 = " + std::to_string(iJet2));
+    PRINT_DEBUG("pickJets: Done.");
 }
 
 
 void PickObjectZmmJet::pickGenMuons(const SkimTree& skimT) {
     pickedGenMuons_.clear();
-    printDebug("Starting pickGenMuons, nGenDressedLepton = " + std::to_string(skimT.nGenDressedLepton));
+    PRINT_DEBUG("Starting pickGenMuons, nGenDressedLepton = " + std::to_string(skimT.nGenDressedLepton));
 
     for (int i = 0; i < skimT.nGenDressedLepton; ++i) {
         if (std::abs(skimT.GenDressedLepton_pdgId[i]) == pdgIdGenMu_) {
             pickedGenMuons_.push_back(i);
-            printDebug("Gen Muon " + std::to_string(i) + " picked");
+            PRINT_DEBUG("Gen Muon " + std::to_string(i) + " picked");
         }
     }
 
-    printDebug("Total Gen Muons Picked: " + std::to_string(pickedGenMuons_.size()));
+    PRINT_DEBUG("Total Gen Muons Picked: " + std::to_string(pickedGenMuons_.size()));
 }
 
 void PickObjectZmmJet::pickGenRefs(const SkimTree& skimT, const TLorentzVector& p4Ref) {
@@ -230,17 +225,17 @@ void PickObjectZmmJet::pickGenRefs(const SkimTree& skimT, const TLorentzVector&
                 TLorentzVector p4GenRef = p4Lep1 + p4Lep2;
                 if (p4GenRef.DeltaR(p4Ref) > maxDeltaRgenRef_) continue;
                 pickedGenRefs_.push_back(p4GenRef);
-                printDebug("Gen Z->ee candidate picked with mass " + std::to_string(p4GenRef.M()));
+                PRINT_DEBUG("Gen Z->ee candidate picked with mass " + std::to_string(p4GenRef.M()));
             }
         }
     }
 
-    printDebug("Total Gen Reference Objects Picked: " + std::to_string(pickedGenRefs_.size()));
+    PRINT_DEBUG("Total Gen Reference Objects Picked: " + std::to_string(pickedGenRefs_.size()));
 }
 
 void PickObjectZmmJet::pickGenJets(const SkimTree& skimT, const int& iJet1, const int& iJet2,
                              const TLorentzVector& p4Jet1, const TLorentzVector& p4Jet2) {
-    printDebug("pickGenJets: Starting, nJet = " + std::to_string(skimT.nGenJet));
+    PRINT_DEBUG("pickGenJets: Starting, nJet = " + std::to_string(skimT.nGenJet));
 
     pickedGenJetsIndex_.clear();
     pickedGenJetsP4_.clear();
@@ -265,7 +260,7 @@ void PickObjectZmmJet::pickGenJets(const SkimTree& skimT, const int& iJet1, cons
     pickedGenJetsP4_.push_back(p4GenJet1);
     pickedGenJetsP4_.push_back(p4GenJet2);
 
-    printDebug("Final Gen Jets: iGenJet1 = " + std::to_string(iGenJet1) +
-               ", iGenJet2 = " + std::to_string(iGenJet2));
+    PRINT_DEBUG("Final Gen Jets: iGenJet1 = " + std::to_string(iGenJet1) +
+                ", iGenJet2 = " + std::to_string(iGenJet2));
 }
 
@@ -0,0 +1,141 @@
+#include "PuWeightTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+auto toEdges(const nlohmann::json& edges) -> std::vector<double> {
+    std::vector<double> out;
+    if (edges.is_object()) { // uniform binning
+        const int n = edges.at("n").get<int>();
+        const double low = edges.at("low").get<double>();
+        const double high = edges.at("high").get<double>();
+        for (int i = 0; i <= n; ++i) out.push_back(low + (high - low) * i / n);
+        return out;
+    }
+    for (const auto& edge : edges) out.push_back(edge.get<double>());
+    return out;
+}
+
+} // namespace
+
+PuWeightTable::PuWeightTable(const correction::Correction::Ref& ref, const nlohmann::json& correctionJson)
+    : ref_(ref) {
+    const nlohmann::json& data = correctionJson.at("data");
+    if (data.value("nodetype", "") != "category") {
+        throw std::runtime_error("PuWeightTable: " + ref->name() + " is not a category of weights");
+    }
+    std::vector<double> values[3];
+    const char* keys[3] = {"nominal", "up", "down"};
+    std::string flow;
+    for (int k = 0; k < 3; ++k) {
+        const nlohmann::json* node = nullptr;
+        for (const auto& item : data.at("content")) {
+            if (item.at("key") == keys[k]) node = &item.at("value");
+        }
+        if (!node || node->value("nodetype", "") != "binning") {
+            throw std::runtime_error("PuWeightTable: no binning for " + std::string(keys[k]) + " in " + ref->name());
+        }
+        const auto edges = toEdges(node->at("edges"));
+        if (k == 0) {
+            edgesStore_ = edges;
+            flow = node->at("flow").is_string() ? node->at("flow").get<std::string>() : "";
+        } else if (edges != edgesStore_) {
+            throw std::runtime_error("PuWeightTable: nominal/up/down of " + ref->name() + " have different edges");
+        }
+        for (const auto& value : node->at("content")) {
+            if (!value.is_number()) {
+                throw std::runtime_error("PuWeightTable: " + ref->name() + " has non-constant bins");
+            }
+            values[k].push_back(value.get<double>());
+        }
+        if (values[k].size() + 1 != edgesStore_.size()) {
+            throw std::runtime_error("PuWeightTable: content of " + ref->name() + " does not match its binning");
+        }
+    }
+    weightsStore_.resize(values[0].size());
+    for (std::size_t i = 0; i < weightsStore_.size(); ++i) {
+        weightsStore_[i] = {values[0][i], values[1][i], values[2][i]};
+    }
+    isClamp_ = flow == "clamp";
+    edges_ = CacheArray<double>(edgesStore_);
+    weights_ = CacheArray<PuWeights>(weightsStore_);
+    setUnitBinning();
+    validate();
+    std::cout << "PuWeightTable: " << ref->name() << ": " << weights_.size << " bins of nominal/up/down" << '\n';
+}
+
+void PuWeightTable::setUnitBinning() {
+    isUnitBinning_ = true;
+    for (std::size_t i = 0; i < edges_.size; ++i) {
+        if (edges_[i] != edges_[0] + static_cast<double>(i)) isUnitBinning_ = false;
+    }
+}
+
+void PuWeightTable::writeTo(CorrectionCacheWriter& writer, const std::string& prefix) const {
+    writer.add(prefix + "/edges", std::vector<double>(edges_.begin(), edges_.end()));
+    writer.add(prefix + "/weights", std::vector<PuWeights>(weights_.begin(), weights_.end()));
+    writer.add(prefix + "/clamp", std::vector<char>{isClamp_ ? '\1' : '\0'});
+}
+
+auto PuWeightTable::fromCache(const std::shared_ptr<const CorrectionCache>& cache, const std::string& prefix,
+                              const correction::Correction::Ref& ref) -> std::unique_ptr<PuWeightTable> {
+    std::unique_ptr<PuWeightTable> table(new PuWeightTable());
+    table->ref_ = ref;
+    table->cache_ = cache;
+    table->edges_ = cache->get<double>(prefix + "/edges");
+    table->weights_ = cache->get<PuWeights>(prefix + "/weights");
+    table->isClamp_ = cache->get<char>(prefix + "/clamp")[0] != '\0';
+    if (table->edges_.size < 2 || table->weights_.size + 1 != table->edges_.size) {
+        throw std::runtime_error("PuWeightTable: inconsistent table sizes in " + prefix);
+    }
+    table->setUnitBinning();
+    return table;
+}
+
+auto PuWeightTable::getRef(double nTrueInt) const -> PuWeights {
+    return {ref_->evaluate({nTrueInt, "nominal"}), ref_->evaluate({nTrueInt, "up"}),
+            ref_->evaluate({nTrueInt, "down"})};
+}
+
+auto PuWeightTable::get(double nTrueInt) const -> PuWeights {
+    const std::size_t nBins = weights_.size;
+    if (!(nTrueInt >= edges_.front() && nTrueInt < edges_.back())) {
+        if (!isClamp_) return getRef(nTrueInt);
+        return nTrueInt < edges_.front() ? weights_.front() : weights_.back();
+    }
+    std::size_t bin;
+    if (isUnitBinning_) {
+        bin = static_cast<std::size_t>(nTrueInt - edges_.front());
+    } else {
+        bin = static_cast<std::size_t>(std::upper_bound(edges_.begin(), edges_.end(), nTrueInt) - edges_.begin()) - 1;
+    }
+    return weights_[std::min(bin, nBins - 1)];
+}
+
+void PuWeightTable::get(std::size_t n, const float* nTrueInt, PuWeights* out) const {
+    for (std::size_t i = 0; i < n; ++i) out[i] = get(nTrueInt[i]);
+}
+
+// Every bin at its center and lower edge, plus both sides of the range
+void PuWeightTable::validate() const {
+    auto check = [&](double x) {
+        const PuWeights a = get(x);
+        const PuWeights b = getRef(x);
+        if (a.nominal != b.nominal || a.up != b.up || a.down != b.down) {
+            throw std::runtime_error("PuWeightTable: differs from correctionlib at nTrueInt = " + std::to_string(x));
+        }
+    };
+    for (std::size_t i = 0; i + 1 < edges_.size; ++i) {
+        check(edges_[i]);
+        check(0.5 * (edges_[i] + edges_[i + 1]));
+    }
+    if (isClamp_) {
+        check(edges_.front() - 1.0);
+        check(edges_.back());
+        check(edges_.back() + 1.0);
+    }
+}
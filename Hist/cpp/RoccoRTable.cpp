@@ -0,0 +1,213 @@
+#include "RoccoRTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<CrystalBall>, "CrystalBall is stored as plain data");
+
+namespace {
+
+// Index i such that x < edges[i + 1] for the first such i in [0, nBins - 1),
+// else nBins - 1: the linear scans of RoccoR as a binary search
+inline auto findBin(const double* edges, int nBins, double x) -> int {
+    return static_cast<int>(std::upper_bound(edges + 1, edges + nBins, x) - (edges + 1));
+}
+
+} // namespace
+
+RoccoRTable::RoccoRTable(const RoccoR& roccor) {
+    if (roccor.empty()) {
+        throw std::runtime_error("RoccoRTable: RoccoR is not initialized");
+    }
+    const auto& rc = roccor.RC[0][0];
+    const auto& rr = rc.RR;
+    nEta_ = roccor.NETA;
+    nPhi_ = roccor.NPHI;
+    mPhi_ = RoccoR::MPHI;
+    dPhi_ = roccor.DPHI;
+    nResEta_ = rr.NETA;
+    nTrk_ = rr.NTRK;
+    nMin_ = rr.NMIN;
+
+    etaEdgesStore_ = roccor.etabin;
+    for (int T : {MC, DT}) {
+        for (int H = 0; H < nEta_; ++H) {
+            for (int F = 0; F < nPhi_; ++F) {
+                const auto& cp = rc.CP[T][H][F];
+                scaleStore_.push_back({cp.M, cp.A, cp.X});
+            }
+        }
+    }
+    for (const auto& res : rr.resol) {
+        resEtaEdgesStore_.push_back(res.eta);
+        kResStore_.insert(kResStore_.end(), {res.kRes[MC], res.kRes[DT]});
+        for (int var = 0; var < 3; ++var) rsParStore_.insert(rsParStore_.end(), res.rsPar[var].begin(), res.rsPar[var].end());
+        cbStore_.insert(cbStore_.end(), res.cb.begin(), res.cb.end());
+    }
+    setViews();
+    std::cout << "RoccoRTable: " << nEta_ << " eta x " << nPhi_ << " phi scale bins, " << nResEta_ << " eta x "
+              << nTrk_ << " tracker-layer resolution bins" << '\n';
+}
+
+void RoccoRTable::setViews() {
+    etaEdges_ = CacheArray<double>(etaEdgesStore_);
+    scale_ = CacheArray<Scale>(scaleStore_);
+    resEtaEdges_ = CacheArray<double>(resEtaEdgesStore_);
+    kRes_ = CacheArray<double>(kResStore_);
+    rsPar_ = CacheArray<double>(rsParStore_);
+    cb_ = CacheArray<CrystalBall>(cbStore_);
+}
+
+void RoccoRTable::writeTo(CorrectionCacheWriter& writer, const std::string& prefix) const {
+    writer.add(prefix + "/meta", std::vector<double>{static_cast<double>(nEta_), static_cast<double>(nPhi_), mPhi_, dPhi_,
+                                                     static_cast<double>(nResEta_), static_cast<double>(nTrk_),
+                                                     static_cast<double>(nMin_)});
+    writer.add(prefix + "/eta", std::vector<double>(etaEdges_.begin(), etaEdges_.end()));
+    writer.add(prefix + "/scale", std::vector<Scale>(scale_.begin(), scale_.end()));
+    writer.add(prefix + "/resEta", std::vector<double>(resEtaEdges_.begin(), resEtaEdges_.end()));
+    writer.add(prefix + "/kRes", std::vector<double>(kRes_.begin(), kRes_.end()));
+    writer.add(prefix + "/rsPar", std::vector<double>(rsPar_.begin(), rsPar_.end()));
+    writer.add(prefix + "/cb", std::vector<CrystalBall>(cb_.begin(), cb_.end()));
+}
+
+auto RoccoRTable::fromCache(const std::shared_ptr<const CorrectionCache>& cache, const std::string& prefix)
+    -> std::unique_ptr<RoccoRTable> {
+    std::unique_ptr<RoccoRTable> table(new RoccoRTable());
+    table->cache_ = cache;
+    const auto meta = cache->get<double>(prefix + "/meta");
+    if (meta.size != 7) {
+        throw std::runtime_error("RoccoRTable: bad meta section in " + prefix);
+    }
+    table->nEta_ = static_cast<int>(meta[0]);
+    table->nPhi_ = static_cast<int>(meta[1]);
+    table->mPhi_ = meta[2];
+    table->dPhi_ = meta[3];
+    table->nResEta_ = static_cast<int>(meta[4]);
+    table->nTrk_ = static_cast<int>(meta[5]);
+    table->nMin_ = static_cast<int>(meta[6]);
+    table->etaEdges_ = cache->get<double>(prefix + "/eta");
+    table->scale_ = cache->get<Scale>(prefix + "/scale");
+    table->resEtaEdges_ = cache->get<double>(prefix + "/resEta");
+    table->kRes_ = cache->get<double>(prefix + "/kRes");
+    table->rsPar_ = cache->get<double>(prefix + "/rsPar");
+    table->cb_ = cache->get<CrystalBall>(prefix + "/cb");
+    const std::size_t nEta = table->nEta_;
+    const std::size_t nRes = table->nResEta_;
+    const std::size_t nTrk = table->nTrk_;
+    if (table->etaEdges_.size != nEta + 1 || table->scale_.size != 2 * nEta * table->nPhi_ ||
+        table->resEtaEdges_.size != nRes || table->kRes_.size != 2 * nRes ||
+        table->rsPar_.size != 3 * nRes * nTrk || table->cb_.size != nRes * nTrk) {
+        throw std::runtime_error("RoccoRTable: inconsistent table sizes in " + prefix);
+    }
+    return table;
+}
+
+// RoccoR::etaBin
+auto RoccoRTable::etaBin(double eta) const -> int {
+    return findBin(etaEdges_.data, nEta_, eta);
+}
+
+// RoccoR::phiBin
+auto RoccoRTable::phiBin(double phi) const -> int {
+    int ibin = (phi - mPhi_) / dPhi_;
+    if (ibin < 0) return 0;
+    if (ibin >= nPhi_) return nPhi_ - 1;
+    return ibin;
+}
+
+// RocRes::etaBin
+auto RoccoRTable::resEtaBin(double absEta) const -> int {
+    return findBin(resEtaEdges_.data, nResEta_, std::fabs(absEta));
+}
+
+// RocRes::Sigma
+auto RoccoRTable::sigma(double pt, int H, int F) const -> double {
+    double dpt = pt - 45;
+    const double* par = &rsPar_[static_cast<std::size_t>(H) * 3 * nTrk_];
+    return par[F] + par[nTrk_ + F]*dpt + par[2 * nTrk_ + F]*dpt*dpt;
+}
+
+// RocRes::kSpread(gpt, rpt, eta)
+auto RoccoRTable::kSpread(double gpt, double rpt, double eta) const -> double {
+    int H = resEtaBin(std::fabs(eta));
+    const double* k = &kRes_[2 * H];
+    double x = gpt/rpt;
+    return x / (1.0 + (x-1.0)*k[DT]/k[MC]);
+}
+
+// RocRes::kExtra(pt, eta, n, u)
+auto RoccoRTable::kExtra(double pt, double eta, int n, double u) const -> double {
+    int H = resEtaBin(std::fabs(eta));
+    int F = n>nMin_ ? n-nMin_ : 0;
+    double d = kRes_[2 * H + DT];
+    double m = kRes_[2 * H + MC];
+    double x = d>m ? std::sqrt(d*d-m*m) * sigma(pt, H, F) * cb_[static_cast<std::size_t>(H) * nTrk_ + F].invcdf(u) : 0;
+    if (x<=-1) return 1.0;
+    return 1.0/(1.0 + x);
+}
+
+auto RoccoRTable::kScaleDT(int Q, double pt, double eta, double phi) const -> double {
+    return scale(DT, etaBin(eta), phiBin(phi)).k(Q, pt);
+}
+
+auto RoccoRTable::kScaleMC(int Q, double pt, double eta, double phi) const -> double {
+    return scale(MC, etaBin(eta), phiBin(phi)).k(Q, pt);
+}
+
+auto RoccoRTable::kSpreadMC(int Q, double pt, double eta, double phi, double gt) const -> double {
+    double k = scale(MC, etaBin(eta), phiBin(phi)).k(Q, pt);
+    return k*kSpread(gt, k*pt, eta);
+}
+
+auto RoccoRTable::kSmearMC(int Q, double pt, double eta, double phi, int n, double u) const -> double {
+    double k = scale(MC, etaBin(eta), phiBin(phi)).k(Q, pt);
+    return k * kExtra(k*pt, eta, n, u);
+}
+
+void RoccoRTable::kScaleDT(std::size_t n, const int* Q, const float* pt, const float* eta, const float* phi,
+                           double* out) const {
+    for (std::size_t i = 0; i < n; ++i) out[i] = kScaleDT(Q[i], pt[i], eta[i], phi[i]);
+}
+
+void RoccoRTable::kSpreadMC(std::size_t n, const int* Q, const float* pt, const float* eta, const float* phi,
+                            const double* gt, double* out) const {
+    for (std::size_t i = 0; i < n; ++i) out[i] = kSpreadMC(Q[i], pt[i], eta[i], phi[i], gt[i]);
+}
+
+void RoccoRTable::kSmearMC(std::size_t n, const int* Q, const float* pt, const float* eta, const float* phi,
+                           const int* nl, const double* u, double* out) const {
+    for (std::size_t i = 0; i < n; ++i) out[i] = kSmearMC(Q[i], pt[i], eta[i], phi[i], nl[i], u[i]);
+}
+
+void RoccoRTable::validate(const RoccoR& roccor, int nPoints, unsigned int seed) const {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> uEta(-2.6, 2.6);
+    std::uniform_real_distribution<double> uPhi(-3.3, 3.3);
+    std::uniform_real_distribution<double> uLogPt(std::log(5.0), std::log(500.0));
+    std::uniform_real_distribution<double> uGen(0.8, 1.2);
+    std::uniform_real_distribution<double> uU(0.0, 1.0);
+    std::uniform_int_distribution<int> uNl(nMin_ - 1, nMin_ + nTrk_ - 1);
+    auto check = [](double a, double b, const char* what) {
+        if (!(a == b || (std::isnan(a) && std::isnan(b)))) {
+            throw std::runtime_error(std::string("RoccoRTable: ") + what + " differs from RoccoR");
+        }
+    };
+    for (int i = 0; i < nPoints; ++i) {
+        const int Q = i % 2 ? 1 : -1;
+        const double pt = std::exp(uLogPt(gen));
+        const double eta = uEta(gen);
+        const double phi = uPhi(gen);
+        const double gt = pt * uGen(gen);
+        const int nl = uNl(gen);
+        const double u = uU(gen);
+        check(kScaleDT(Q, pt, eta, phi), roccor.kScaleDT(Q, pt, eta, phi), "kScaleDT");
+        check(kScaleMC(Q, pt, eta, phi), roccor.kScaleMC(Q, pt, eta, phi), "kScaleMC");
+        check(kSpreadMC(Q, pt, eta, phi, gt), roccor.kSpreadMC(Q, pt, eta, phi, gt), "kSpreadMC");
+        check(kSmearMC(Q, pt, eta, phi, nl, u), roccor.kSmearMC(Q, pt, eta, phi, nl, u), "kSmearMC");
+    }
+    std::cout << "RoccoRTable: identical to RoccoR on " << nPoints << " random muons" << '\n';
+}
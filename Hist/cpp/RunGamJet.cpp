@@ -86,6 +86,14 @@ auto RunGamJet::Run(std::shared_ptr<SkimTree>& skimT, PickEvent *pickEvent, Scal
     TLorentzVector p4GenJeti, p4GenJet1, p4GenJet2;
     MathHdm mathHdm(globalFlags_);
 
+    // HLT lumi table ID of each trigger of passHltWithPt, resolved once
+    std::vector<int> hltLumiTrigIds;
+    if (globalFlags_.isData()) {
+        for (const auto& trigName : pickEvent->getTrigNamesRangePt()) {
+            hltLumiTrigIds.push_back(scaleEvent->getHltLumiTrigId(trigName));
+        }
+    }
+
     double totalTime = 0.0;
     auto startClock = std::chrono::high_resolution_clock::now();
     Long64_t nentries = skimT->getEntries();
@@ -96,7 +104,8 @@ auto RunGamJet::Run(std::shared_ptr<SkimTree>& skimT, PickEvent *pickEvent, Scal
         Helper::printProgress(jentry, nentries, startClock, totalTime, globalFlags_.isDebug());
         Long64_t ientry = skimT->loadEntry(jentry);
         if (ientry < 0) break; 
-        skimT->getChain()->GetTree()->GetEntry(ientry);
+        if (!skimT->passSkimSelection(ientry)) continue;
+        skimT->readEntry(ientry);
         h1EventInCutflow->fill("passSkim");
 
         //------------------------------------
@@ -152,7 +161,7 @@ auto RunGamJet::Run(std::shared_ptr<SkimTree>& skimT, PickEvent *pickEvent, Scal
         double weightLumiPerHlt = 1.0;
         if (globalFlags_.isData()){
             double lumiPerHlt = 1.0;
-            lumiPerHlt = scaleEvent->cacheHltLumiPerRun(pickEvent->getPassedHlt(), skimT->run);
+            lumiPerHlt = scaleEvent->getHltLumi(hltLumiTrigIds[pickEvent->getPassedHltIndex()], skimT->run);
             lumiPerHlt *= 10e-9; //convert ub-1 to fb-1
             //Scale each HLT to the lumi of full Era
             if(lumiPerHlt>0.0) weightLumiPerHlt *= (scaleEvent->getLumiPerEra()/lumiPerHlt);
@@ -85,7 +85,8 @@ auto RunGamJetFake::Run(std::shared_ptr<SkimTree>& skimT, PickEvent *pickEvent,
         Helper::printProgress(jentry, nentries, startClock, totalTime, globalFlags_.isDebug());
         Long64_t ientry = skimT->loadEntry(jentry);
         //if (ientry < 0) break; 
-        skimT->getChain()->GetTree()->GetEntry(ientry);
+        if (!skimT->passSkimSelection(ientry)) continue;
+        skimT->readEntry(ientry);
         h1EventInCutflow->fill("passSkim");
 
         // Weight
@@ -48,13 +48,19 @@ auto RunMultiJet::Run(std::shared_ptr<SkimTree>& skimT, PickEvent *pickEvent, Pi
     // Initialize TrigDetail
     TrigDetail trigDetail(globalFlags_);
     const auto& trigDetails = trigDetail.getTrigMapRangePtEta();
-    std::map<std::string, HistMultiJet*> mapHistMultiJet;
+    // Histograms per trigger, keyed by the SkimTree trigger ID: the event
+    // loop tests bits of PickEvent::getPassedHltBits(), no string lookups
+    std::vector<std::pair<int, HistMultiJet*>> histMultiJetPerTrig;
+    SkimTree::TrigBits multiJetTrigBits;
     for (const auto& trigPair : trigDetails) {
         const std::string& trigName = trigPair.first;
         const TrigRangePtEta& r = trigPair.second;
+        const int trigId = skimT->getTrigId(trigName);
+        if (trigId < 0) continue; // never fires
         HistMultiJet* hMultiJet = new HistMultiJet(origDir, "passMultiJet/"+trigName, varBin);
         hMultiJet->trigPt = r.trigPt; 
-        mapHistMultiJet[trigName] = hMultiJet;
+        histMultiJetPerTrig.emplace_back(trigId, hMultiJet);
+        multiJetTrigBits.set(trigId);
     } // End of trig loop
 
     auto scaleJetMet = std::make_shared<ScaleJetMet>(scaleObject, globalFlags_.isData(), VarCut::applyJer);
@@ -85,14 +91,15 @@ auto RunMultiJet::Run(std::shared_ptr<SkimTree>& skimT, PickEvent *pickEvent, Pi
         Helper::printProgress(jentry, nentries, startClock, totalTime, globalFlags_.isDebug());
         Long64_t ientry = skimT->loadEntry(jentry);
         if (ientry < 0) break; 
-        skimT->getChain()->GetTree()->GetEntry(ientry);
+        if (!skimT->passSkimSelection(ientry)) continue;
+        skimT->readEntry(ientry);
         h1EventInCutflow->fill("passSkim");
 
         //------------------------------------
         // Trigger and golden lumi
         //------------------------------------
         if (!pickEvent->passHlt(skimT)) continue;
-        std::vector<std::string> passedHlts = pickEvent->getPassedHlts();
+        const SkimTree::TrigBits& passedHltBits = pickEvent->getPassedHltBits();
         h1EventInCutflow->fill("passHLT");
 
         bool passGoodLumi = true;
@@ -309,13 +316,11 @@ auto RunMultiJet::Run(std::shared_ptr<SkimTree>& skimT, PickEvent *pickEvent, Pi
         fillInputs.mnr       = mathHdm.mpfResponse(p4SumOther, p4R, ptRecoil, offsetZero);
         fillInputs.mur       = mathHdm.mpfResponse(p4Unclustered, p4R, ptRecoil, offsetZero);
 
-        for (const auto& trigPair : trigDetails) {
-            const std::string& trigName = trigPair.first;
-            bool isPresent = std::find(passedHlts.begin(), passedHlts.end(),
-                                       trigName) != passedHlts.end();
-            if (!isPresent) continue;
+        // Triggers with their own histograms that fired in this event
+        const SkimTree::TrigBits firedMultiJetTrigs = passedHltBits & multiJetTrigBits;
+        for (const auto& [trigId, h] : histMultiJetPerTrig) {
+            if (!firedMultiJetTrigs.test(trigId)) continue;
             //Fill HistMultiJet
-            HistMultiJet* h = mapHistMultiJet[trigName];
             h->setInputs(fillInputs);
             for (int i = 0; i != recoilIndices.size(); ++i) {
                 histMultiJet.fillJetLevelHistos(skimT.get(), recoilIndices.at(i), weight * recoilFs.at(i));
@@ -334,11 +339,7 @@ auto RunMultiJet::Run(std::shared_ptr<SkimTree>& skimT, PickEvent *pickEvent, Pi
         for (int i = 0; i != recoilIndices.size(); ++i) {
             histMultiJet.fillJetLevelHistos(skimT.get(), recoilIndices.at(i), weight* recoilFs.at(i));
         } 
-        double trigPt = 1.0;
-        auto it = trigDetails.find(pickEvent->getPassedHlt());
-        if (it != trigDetails.end()) {
-            trigPt = it->second.trigPt;
-        }
+        const double trigPt = pickEvent->getPassedHltRangePtEta().trigPt;
         histMultiJet.fillEventLevelHistos(skimT.get(), iJet1, trigPt);
 
         //Fill other histograms
@@ -82,7 +82,8 @@ auto RunWqqm::Run(std::shared_ptr<SkimTree>& skimT, PickEvent *pickEvent, PickOb
        
         Long64_t ientry = skimT->loadEntry(jentry);
         if (ientry < 0) break; 
-        skimT->getChain()->GetTree()->GetEntry(ientry);
+        if (!skimT->passSkimSelection(ientry)) continue;
+        skimT->readEntry(ientry);
         h1EventInCutflow->fill("passSkim");
 
         //------------------------------------
@@ -96,7 +96,8 @@ auto RunZmmJet::Run(std::shared_ptr<SkimTree>& skimT, PickEvent *pickEvent, Scal
        
         Long64_t ientry = skimT->loadEntry(jentry);
         if (ientry < 0) break; 
-        skimT->getChain()->GetTree()->GetEntry(ientry);
+        if (!skimT->passSkimSelection(ientry)) continue;
+        skimT->readEntry(ientry);
         h1EventInCutflow->fill("passSkim");
 
         //------------------------------------
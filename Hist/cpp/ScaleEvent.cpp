@@ -1,7 +1,11 @@
 #include "ScaleEvent.h"
+#include "CorrectionRegistry.h"
 #include "TrigDetail.h"
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <regex>
+#include <sstream>
 #include <stdexcept>  // For std::runtime_error
 #include <ReadConfig.h>
 
@@ -68,16 +72,72 @@ void ScaleEvent::setLumiPerEra(double lumiPerEra){
     lumiPerEra_ = lumiPerEra;
 }
 
+void ScaleEvent::setCorrectionCache(const std::shared_ptr<const CorrectionCache>& cache) {
+  cache_ = cache;
+}
+
+// From the mapped cache if it has the correction of this file, else from the JSON
+auto ScaleEvent::loadCorrection(const std::string& jsonPath, const std::string& name) const -> correction::Correction::Ref {
+  const std::string section = "corr/" + jsonPath + "/" + name;
+  if (cache_ && cache_->has(section)) {
+    return CorrectionRegistry::getInstance().getCorrection(*cache_, section, name);
+  }
+  return CorrectionRegistry::getInstance().getCorrection(jsonPath, name);
+}
+
+void ScaleEvent::writeCorrectionCache(CorrectionCacheWriter& writer) const {
+  std::cout << "==> ScaleEvent::writeCorrectionCache()" << '\n';
+  auto& registry = CorrectionRegistry::getInstance();
+  if (loadedJetVetoRef_) {
+    writer.addText("corr/" + jetVetoJsonPath_ + "/" + jetVetoName_,
+                   registry.getStandaloneJson(jetVetoJsonPath_, jetVetoName_));
+    if (jetVetoBitmap_) {
+      jetVetoBitmap_->writeTo(writer, "veto/" + jetVetoJsonPath_ + "/" + jetVetoName_ + "/" + jetVetoKey_);
+    }
+    writer.addSource(jetVetoJsonPath_);
+  }
+  if (loadedPuRef_) {
+    writer.addText("corr/" + puJsonPath_ + "/" + puName_, registry.getStandaloneJson(puJsonPath_, puName_));
+    if (puWeightTable_) puWeightTable_->writeTo(writer, "pu/" + puJsonPath_ + "/" + puName_);
+    writer.addSource(puJsonPath_);
+  }
+  if (!goldenLumi_.empty()) {
+    writer.add("lumi/golden/" + goldenLumiJsonPath_, std::vector<LumiRange>(goldenLumi_.begin(), goldenLumi_.end()));
+    writer.addSource(goldenLumiJsonPath_);
+  }
+  if (!hltLumi_.empty()) {
+    std::string paths;
+    for (const auto& path : hltPaths_) paths += path + '\n';
+    writer.addText("lumi/hltPaths/" + hltLumiJsonPath_, paths);
+    writer.add("lumi/hltRecords/" + hltLumiJsonPath_, std::vector<HltLumiRecord>(hltLumi_.begin(), hltLumi_.end()));
+    writer.addSource(hltLumiJsonPath_);
+  }
+}
+
 void ScaleEvent::loadJetVetoRef() {
   std::cout << "==> loadJetVetoRef()" << '\n';
   try {
-    loadedJetVetoRef_ = correction::CorrectionSet::from_file(jetVetoJsonPath_)->at(jetVetoName_);
+    loadedJetVetoRef_ = loadCorrection(jetVetoJsonPath_, jetVetoName_);
   } catch (const std::exception &e) {
     std::cerr << "\nEXCEPTION: ScaleEvent::loadJetVetoRef()" << '\n';
     std::cerr << "Check " << jetVetoJsonPath_ << " or " << jetVetoName_ << '\n';
     std::cerr << e.what() << '\n';
     throw std::runtime_error("Failed to load Jet Veto Reference");
   }
+  const std::string bitmapPrefix = "veto/" + jetVetoJsonPath_ + "/" + jetVetoName_ + "/" + jetVetoKey_;
+  try {
+    if (cache_ && cache_->has(bitmapPrefix + "/bits")) {
+      jetVetoBitmap_ = JetVetoBitmap::fromCache(cache_, bitmapPrefix, loadedJetVetoRef_);
+    } else {
+      const auto& correctionJson = CorrectionRegistry::getInstance().getCorrectionJson(jetVetoJsonPath_, jetVetoName_);
+      jetVetoBitmap_ = std::make_unique<JetVetoBitmap>(loadedJetVetoRef_, correctionJson, jetVetoKey_);
+    }
+    jetVetoBitmap_->validate(10000);
+  } catch (const std::exception &e) {
+    // Not fatal: checkJetVetoMap() stays on correctionlib
+    std::cerr << "Warning: no bitmap for " << jetVetoName_ << "/" << jetVetoKey_ << ": " << e.what() << '\n';
+    jetVetoBitmap_.reset();
+  }
 }
 
 auto ScaleEvent::checkJetVetoMap(const SkimTree& skimT) const -> bool {
@@ -85,6 +145,20 @@ auto ScaleEvent::checkJetVetoMap(const SkimTree& skimT) const -> bool {
   const double maxEtaInMap = 5.191;
   const double maxPhiInMap = 3.1415926;
 
+  if (jetVetoBitmap_ && !isDebug_) {
+    std::array<std::uint8_t, SkimTree::nJetMax> use{};
+    for (int i = 0; i != skimT.nJet; ++i) {
+      use[i] = std::abs(skimT.Jet_eta[i]) <= maxEtaInMap && std::abs(skimT.Jet_phi[i]) <= maxPhiInMap &&
+               skimT.Jet_jetId[i] >= 6;
+    }
+    try {
+      return jetVetoBitmap_->isAnyVetoed(skimT.nJet, skimT.Jet_eta, skimT.Jet_phi, use.data());
+    } catch (const std::exception &e) {
+      std::cerr << "\nEXCEPTION: in checkJetVetoMap(): " << e.what() << '\n';
+      throw std::runtime_error("Failed to check Jet Veto Map");
+    }
+  }
+
   try {
     for (int i = 0; i != skimT.nJet; ++i) {
       if (std::abs(skimT.Jet_eta[i]) > maxEtaInMap) continue;
@@ -115,6 +189,7 @@ auto ScaleEvent::checkJetVetoMap(const SkimTree& skimT) const -> bool {
 auto ScaleEvent::checkJetVetoMapOnJet1(const TLorentzVector& p4Jet1) const -> bool {
   bool isVeto = false;
   try {
+      if (jetVetoBitmap_ && !isDebug_) return jetVetoBitmap_->isVetoed(p4Jet1.Eta(), p4Jet1.Phi());
       auto jvNumber = loadedJetVetoRef_->evaluate({jetVetoKey_, p4Jet1.Eta(), p4Jet1.Phi()});
       if (isDebug_) {
         std::cout << 
@@ -139,28 +214,54 @@ auto ScaleEvent::checkJetVetoMapOnJet1(const TLorentzVector& p4Jet1) const -> bo
 //-------------------------------------
 void ScaleEvent::loadGoldenLumiJson() {
   std::cout << "==> loadGoldenLumiJson()" << '\n';
+  memoRunBegin_ = memoRunEnd_ = nullptr;
+  memoRun_ = 0;
+  if (cache_ && cache_->has("lumi/golden/" + goldenLumiJsonPath_)) {
+    goldenLumi_ = cache_->get<LumiRange>("lumi/golden/" + goldenLumiJsonPath_);
+    return;
+  }
   std::ifstream file(goldenLumiJsonPath_);
-  file >> loadedGoldenLumiJson_;
+  nlohmann::json goldenLumiJson;
+  file >> goldenLumiJson;
+  goldenLumiStore_.clear();
+  for (const auto& [run, lumiBlocks] : goldenLumiJson.items()) {
+    for (const auto& lumiBlock : lumiBlocks) {
+      goldenLumiStore_.push_back({static_cast<std::uint32_t>(std::stoul(run)),
+                                  lumiBlock[0].get<std::uint32_t>(), lumiBlock[1].get<std::uint32_t>()});
+    }
+  }
+  std::sort(goldenLumiStore_.begin(), goldenLumiStore_.end(), [](const LumiRange& a, const LumiRange& b) {
+    return a.run != b.run ? a.run < b.run : a.first < b.first;
+  });
+  // Merge overlapping and adjacent ranges of a run
+  std::vector<LumiRange> merged;
+  for (const auto& range : goldenLumiStore_) {
+    if (!merged.empty() && merged.back().run == range.run && range.first <= merged.back().last + 1) {
+      merged.back().last = std::max(merged.back().last, range.last);
+    } else {
+      merged.push_back(range);
+    }
+  }
+  goldenLumiStore_.swap(merged);
+  goldenLumi_ = CacheArray<LumiRange>(goldenLumiStore_);
 }
 
 auto ScaleEvent::checkGoodLumi(const unsigned int &run, const unsigned int &lumi) const -> bool {
-  try {
-    auto it = loadedGoldenLumiJson_.find(std::to_string(run));
-    if (it == loadedGoldenLumiJson_.end()) {
-      return false;
-    }
-    for (const auto &lumiBlock : it.value()) {
-      if (lumi >= lumiBlock[0] && lumi <= lumiBlock[1]) {
-        return true;
-      }
-    }
-  } catch (const std::exception &e) {
-    std::cout << "\nEXCEPTION: ScaleEvent::checkGoodLumi()" << '\n';
-    std::cout << e.what() << '\n';
-    throw std::runtime_error("Error checking good luminosity.");
+  if (run == memoRun_ && memoRunBegin_ && lumi == memoLumi_) return memoIsGood_;
+  if (run != memoRun_ || !memoRunBegin_) {
+    const auto byRun = std::equal_range(goldenLumi_.begin(), goldenLumi_.end(), LumiRange{run, 0, 0},
+                                        [](const LumiRange& a, const LumiRange& b) { return a.run < b.run; });
+    memoRun_ = run;
+    memoRunBegin_ = byRun.first;
+    memoRunEnd_ = byRun.second;
   }
-  if(isDebug_) std::cout << "Run = " << run << ", Lumi = " << lumi << '\n';
-  return false;
+  // Last range starting at or before lumi
+  const auto it = std::upper_bound(memoRunBegin_, memoRunEnd_, lumi,
+                                   [](unsigned int l, const LumiRange& range) { return l < range.first; });
+  memoLumi_ = lumi;
+  memoIsGood_ = it != memoRunBegin_ && lumi <= (it - 1)->last;
+  if (!memoIsGood_ && isDebug_) std::cout << "Run = " << run << ", Lumi = " << lumi << '\n';
+  return memoIsGood_;
 }
 
 
@@ -169,33 +270,113 @@ auto ScaleEvent::checkGoodLumi(const unsigned int &run, const unsigned int &lumi
 //-------------------------------------
 void ScaleEvent::loadHltLumiJson() {
   std::cout << "==> loadHltLumiJson()" << '\n';
+  hltPaths_.clear();
+  if (cache_ && cache_->has("lumi/hltRecords/" + hltLumiJsonPath_)) {
+    std::istringstream paths(cache_->getText("lumi/hltPaths/" + hltLumiJsonPath_));
+    std::string path;
+    while (std::getline(paths, path)) hltPaths_.push_back(path);
+    hltLumi_ = cache_->get<HltLumiRecord>("lumi/hltRecords/" + hltLumiJsonPath_);
+    buildHltLumiTable();
+    return;
+  }
   std::ifstream file(hltLumiJsonPath_);
-  file >> loadedHltLumiJson_;
+  nlohmann::json hltLumiJson;
+  file >> hltLumiJson;
+  hltLumiStore_.clear();
+  for (const auto& [hltPath, runs] : hltLumiJson.items()) {
+    const auto pathIndex = static_cast<std::uint32_t>(hltPaths_.size());
+    hltPaths_.push_back(hltPath);
+    for (const auto& [run, records] : runs.items()) {
+      // Keep the first valid 'recorded' luminosity of the run
+      for (const auto& record : records) {
+        if (record.contains("recorded") && record["recorded"].is_number()) {
+          hltLumiStore_.push_back({pathIndex, static_cast<std::uint32_t>(std::stoul(run)),
+                                   record["recorded"].get<double>()});
+          break;
+        }
+        std::cerr << "Warning: 'recorded' field missing or not a number in record: " << record << std::endl;
+      }
+    }
+  }
+  std::sort(hltLumiStore_.begin(), hltLumiStore_.end(), [](const HltLumiRecord& a, const HltLumiRecord& b) {
+    return a.path != b.path ? a.path < b.path : a.run < b.run;
+  });
+  hltLumi_ = CacheArray<HltLumiRecord>(hltLumiStore_);
+  buildHltLumiTable();
+}
+
+void ScaleEvent::buildHltLumiTable() {
+  static const std::regex versionSuffix("_v\\d+$");
+  // Trigger of each path, -1 for paths without version suffix
+  std::vector<int> pathTrig(hltPaths_.size(), -1);
+  hltTrigIds_.clear();
+  for (std::size_t iPath = 0; iPath < hltPaths_.size(); ++iPath) {
+    std::smatch match;
+    if (!std::regex_search(hltPaths_[iPath], match, versionSuffix)) continue;
+    const std::string trigName = hltPaths_[iPath].substr(0, match.position(0));
+    auto it = hltTrigIds_.emplace(trigName, static_cast<int>(hltTrigIds_.size())).first;
+    pathTrig[iPath] = it->second;
+  }
+
+  std::vector<std::uint32_t> runs;
+  for (const auto& record : hltLumi_) runs.push_back(record.run);
+  std::sort(runs.begin(), runs.end());
+  runs.erase(std::unique(runs.begin(), runs.end()), runs.end());
+  hltNRuns_ = runs.size();
+  hltFirstRun_ = runs.empty() ? 0 : runs.front();
+  hltRunIndex_.assign(runs.empty() ? 0 : runs.back() - runs.front() + 1, -1);
+  for (std::size_t iRun = 0; iRun < runs.size(); ++iRun) hltRunIndex_[runs[iRun] - hltFirstRun_] = static_cast<int>(iRun);
+
+  // Records are sorted by path, so the first path of a trigger fills its cell
+  hltLumiTable_.assign(hltTrigIds_.size() * hltNRuns_, 0.0);
+  std::vector<bool> isFilled(hltLumiTable_.size(), false);
+  for (const auto& record : hltLumi_) {
+    const int trigId = pathTrig[record.path];
+    if (trigId < 0) continue;
+    const std::size_t cell = static_cast<std::size_t>(trigId) * hltNRuns_ + hltRunIndex_[record.run - hltFirstRun_];
+    if (isFilled[cell]) continue;
+    hltLumiTable_[cell] = record.recorded;
+    isFilled[cell] = true;
+  }
+  std::cout << "HLT lumi table: " << hltTrigIds_.size() << " triggers x " << hltNRuns_ << " runs" << '\n';
+
+  if (isDebug_) {
+    // Cross-check against the regex lookup
+    for (const auto& [trigName, trigId] : hltTrigIds_) {
+      for (const auto run : runs) {
+        if (!isFilled[static_cast<std::size_t>(trigId) * hltNRuns_ + hltRunIndex_[run - hltFirstRun_]]) continue;
+        if (getHltLumi(trigId, run) != getHltLumiPerRun(trigName, std::to_string(run))) {
+          throw std::runtime_error("HLT lumi table differs for " + trigName + " in run " + std::to_string(run));
+        }
+      }
+    }
+  }
+}
+
+auto ScaleEvent::getHltLumiTrigId(const std::string& trigName) const -> int {
+  auto it = hltTrigIds_.find(trigName);
+  if (it == hltTrigIds_.end()) {
+    std::cerr << "Warning: no HLT path " << trigName << "_v* in " << hltLumiJsonPath_ << std::endl;
+    return -1;
+  }
+  return it->second;
 }
 
 double ScaleEvent::getHltLumiPerRun(const std::string& hltPathBase, const std::string& runNumber) const {
-    double recordedLumi = 0.0;
     // Construct a regex to match HLT paths that start with hltPathBase_v followed by digits
     // Example: ^HLT_Photon20_v\d+$
     std::string regexPattern = "^" + hltPathBase + "_v\\d+$";
     std::regex hltRegex(regexPattern);
-    // Iterate over all HLT paths in the JSON
-    for (const auto& [currentHltPath, runs] : loadedHltLumiJson_.items()) {
-        // Use regex to match the HLT path
-        if (std::regex_match(currentHltPath, hltRegex)) {
-            // Check if the specified run exists within this HLT path
-            if (runs.contains(runNumber)) {
-                const nlohmann::json& records = runs.at(runNumber);
-                // Iterate over all records for this run and retrieve 'recorded' luminosity
-                for (const auto& record : records) {
-                    if (record.contains("recorded") && record["recorded"].is_number()) {
-                        recordedLumi = record["recorded"].get<double>();
-                        return recordedLumi; // Return upon finding the first valid record
-                    } else {
-                        std::cerr << "Warning: 'recorded' field missing or not a number in record: " << record << std::endl;
-                    }
-                }
-            }
+    const auto run = static_cast<std::uint32_t>(std::stoul(runNumber));
+    // Iterate over all HLT paths, in the order of the JSON
+    for (std::uint32_t iPath = 0; iPath < hltPaths_.size(); ++iPath) {
+        if (!std::regex_match(hltPaths_[iPath], hltRegex)) continue;
+        const HltLumiRecord key{iPath, run, 0.0};
+        auto it = std::lower_bound(hltLumi_.begin(), hltLumi_.end(), key, [](const HltLumiRecord& a, const HltLumiRecord& b) {
+            return a.path != b.path ? a.path < b.path : a.run < b.run;
+        });
+        if (it != hltLumi_.end() && it->path == iPath && it->run == run) {
+            return it->recorded; // Return upon finding the first valid record
         }
     }
 
@@ -205,51 +386,6 @@ double ScaleEvent::getHltLumiPerRun(const std::string& hltPathBase, const std::s
     return 0.0;
 }
 
-double ScaleEvent::cacheHltLumiPerRun(const std::string& trigName, const double & run) const {
-    if (isDebug_) printRunTriggerLumiCache(); 
-    // 1) Extract the run number as an integer
-    int currentRun = run;
-
-    // We'll need to return the luminosity for *the first triggered path*,
-    // but now we maintain distinct values for each (run, trigger).
-    double matchedLumi = 0.0;
-
-    if (channel_ == GlobalFlag::Channel::GamJet) {
-        //We check if we already have a cached luminosity for (run, triggerName).
-        auto runIter = run2Trig2Lumi_.find(currentRun);
-        if (runIter == run2Trig2Lumi_.end()) {
-            // No entry for this run yet, so create one
-            run2Trig2Lumi_[currentRun] = {};
-            runIter = run2Trig2Lumi_.find(currentRun);
-        }
-
-        auto& trig2lumiMap = runIter->second; // This is the map triggerName -> lumi
-        if (trig2lumiMap.find(trigName) == trig2lumiMap.end()) {
-            // Not in cache, so we do the JSON lookup
-            double newLumi = getHltLumiPerRun(trigName, std::to_string(currentRun));
-            trig2lumiMap[trigName] = newLumi;
-        }
-
-        // 2b) Retrieve the cached luminosity for (run, triggerName)
-        matchedLumi = trig2lumiMap[trigName];
-
-    } // end if GamJet
-
-    return matchedLumi;
-}
-
-void ScaleEvent::printRunTriggerLumiCache() const {
-    std::cout << "\n==> ScaleEvent::printRunTriggerLumiCache(): Current Cache Contents\n";
-    // Iterate over the outer map (run -> trigger -> luminosity)
-    for (const auto& [run, trig2lumi] : run2Trig2Lumi_) {
-        std::cout << "Run: " << run << "\n";
-        for (const auto& [trigger, lumi] : trig2lumi) {
-            std::cout << "  Trigger: " << trigger 
-                      << ", Luminosity: " << lumi << " ub^-1\n";
-        }
-    }
-}
-
 
 //-------------------------------------
 // Pileup Json 
@@ -257,19 +393,40 @@ void ScaleEvent::printRunTriggerLumiCache() const {
 void ScaleEvent::loadPuRef() {
   std::cout << "==> loadPuRef()" << '\n';
   try {
-    loadedPuRef_ = correction::CorrectionSet::from_file(puJsonPath_)->at(puName_);
+    loadedPuRef_ = loadCorrection(puJsonPath_, puName_);
   } catch (const std::exception &e) {
     std::cout << "\nEXCEPTION: ScaleEvent::loadPuRef()" << '\n';
     std::cout << "Check " << puJsonPath_ << " or " << puName_ << '\n';
     std::cout << e.what() << '\n';
     throw std::runtime_error("Error loading Pileup Reference.");
   }
+  try {
+    const std::string tablePrefix = "pu/" + puJsonPath_ + "/" + puName_;
+    if (cache_ && cache_->has(tablePrefix + "/weights")) {
+      puWeightTable_ = PuWeightTable::fromCache(cache_, tablePrefix, loadedPuRef_);
+    } else {
+      const auto& correctionJson = CorrectionRegistry::getInstance().getCorrectionJson(puJsonPath_, puName_);
+      puWeightTable_ = std::make_unique<PuWeightTable>(loadedPuRef_, correctionJson);
+    }
+  } catch (const std::exception &e) {
+    // Not fatal: getPuCorrection() stays on correctionlib
+    std::cerr << "Warning: no pileup weight table for " << puName_ << ": " << e.what() << '\n';
+    puWeightTable_.reset();
+  }
 }
 
 auto ScaleEvent::getPuCorrection(Float_t nTrueInt, const std::string &nomOrSyst) const -> double {
   double puSf = 1.0;
   try {
-    puSf = loadedPuRef_->evaluate({nTrueInt, nomOrSyst.c_str()});
+    if (puWeightTable_ && nomOrSyst == "nominal") {
+      puSf = puWeightTable_->get(nTrueInt).nominal;
+    } else if (puWeightTable_ && nomOrSyst == "up") {
+      puSf = puWeightTable_->get(nTrueInt).up;
+    } else if (puWeightTable_ && nomOrSyst == "down") {
+      puSf = puWeightTable_->get(nTrueInt).down;
+    } else {
+      puSf = loadedPuRef_->evaluate({nTrueInt, nomOrSyst.c_str()});
+    }
     if (isDebug_) std::cout << "nomOrSyst = " << nomOrSyst 
               << ", nTrueInt = " << nTrueInt 
               << ", puSf= " << puSf << '\n';
@@ -280,3 +437,24 @@ auto ScaleEvent::getPuCorrection(Float_t nTrueInt, const std::string &nomOrSyst)
   return puSf;
 }
 
+auto ScaleEvent::getPuWeights(Float_t nTrueInt) const -> PuWeights {
+  PuWeights weights;
+  getPuWeights(1, &nTrueInt, &weights);
+  return weights;
+}
+
+void ScaleEvent::getPuWeights(std::size_t n, const Float_t* nTrueInt, PuWeights* out) const {
+  try {
+    if (puWeightTable_) {
+      puWeightTable_->get(n, nTrueInt, out);
+      return;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      out[i] = {loadedPuRef_->evaluate({nTrueInt[i], "nominal"}), loadedPuRef_->evaluate({nTrueInt[i], "up"}),
+                loadedPuRef_->evaluate({nTrueInt[i], "down"})};
+    }
+  } catch (const std::exception &e) {
+    std::cout << "\nEXCEPTION: in ScaleEvent::getPuWeights(): " << e.what() << '\n';
+    throw std::runtime_error("Error calculating Pileup Correction.");
+  }
+}
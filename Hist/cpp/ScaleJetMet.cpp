@@ -1,38 +1,45 @@
 #include "ScaleJetMet.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <iomanip>
+#include <stdexcept>
+#include <type_traits>
 
 // Constructor
 ScaleJetMet::ScaleJetMet(ScaleObject *scaleObj, bool isData, bool applyJer)
     : scaleObj_(scaleObj), isData_(isData), applyJer_(applyJer) {
+    // One chain per level, fixed for the job by isData and applyJer
+    for (int level = 0; level < nCorrectionLevels; ++level) {
+        unsigned mask = 0;
+        if (level >= static_cast<int>(CorrectionLevel::L1Rc)) mask |= JetLevelChain::L1Rc;
+        if (level >= static_cast<int>(CorrectionLevel::L2Rel)) mask |= JetLevelChain::L2Rel;
+        if (level >= static_cast<int>(CorrectionLevel::L2L3Res) && isData_) mask |= JetLevelChain::L2L3Res;
+        if (applyJer_ && !isData_) mask |= JetLevelChain::Jer;
+        chains_[level] = chainFor(mask);
+    }
     Initialize();
 }
 
-void ScaleJetMet::Initialize() {
-    // Clear existing corrections
-    p4MapJet1_.clear();
-    p4MapSelJetSum_.clear();
-    p4MapMet_.clear();
-
-    // Initialize jet corrections with labels
-    std::vector<std::string> jecNames = {
-        "Nano", "Raw", "L1RcCorr", "L2RelCorr", "L2L3ResCorr", "JerCorr", "Corr"
-    };
+// All 16 instantiations of runChain, indexed by mask
+template <unsigned... kMasks>
+constexpr auto ScaleJetMet::makeChains(std::integer_sequence<unsigned, kMasks...>)
+    -> std::array<Chain, sizeof...(kMasks)> {
+    return {&ScaleJetMet::runChain<kMasks>...};
+}
 
-    for (const auto& name : jecNames) {
-        p4MapJet1_[name] = TLorentzVector();
-        p4MapSelJetSum_[name] = TLorentzVector();
-    }
+auto ScaleJetMet::chainFor(unsigned mask) -> Chain {
+    static constexpr auto chains = makeChains(std::make_integer_sequence<unsigned, 1u << JetLevelChain::nSteps>{});
+    return chains[mask];
+}
 
-    // Initialize MET labels
-    std::vector<std::string> metNames = {
-        "Nano", "Corr"
-    };
-    for (const auto& name : metNames) {
-        p4MapMet_[name] = TLorentzVector();
-    }
-    p4SumAllNano_ = TLorentzVector();
-    p4SumCorrAndUnCorr_ = TLorentzVector();
+void ScaleJetMet::Initialize() {
+    p4Jet1_.fill(P4());
+    p4SelJetSum_.fill(P4());
+    p4Met_.fill(P4());
+    p4SumAllNano_ = P4();
+    p4SumCorrAndUnCorr_ = P4();
+    hasLevelSums_ = false;
 }
 
 // Apply corrections
@@ -48,137 +55,230 @@ void ScaleJetMet::applyCorrections(std::shared_ptr<SkimTree>& skimT, CorrectionL
         return;
     }
     Initialize();
+    (this->*chains_[static_cast<int>(level)])(*skimT);
+    if (scaleObj_->isDebug()) validateSums(*skimT);
+}
 
-    TLorentzVector p4Met;
-    p4Met.SetPtEtaPhiM(skimT->ChsMET_pt, 0, skimT->ChsMET_phi, 0);
-    p4MapMet_["Nano"] = p4Met;
-
-    for (int i = 0; i < skimT->nJet; ++i) {
-        TLorentzVector p4Jet;
-        // JECs are not reliable for low pTs and high etas. It is better
-        // to skip such jets than applying unreliable JEC
-        if(skimT->Jet_pt[i] > 15 && std::abs(skimT->Jet_eta[i]) < 5.2){ 
-            // Original NanoAOD jet
-            p4Jet.SetPtEtaPhiM(skimT->Jet_pt[i], skimT->Jet_eta[i],
-                               skimT->Jet_phi[i], skimT->Jet_mass[i]);
-            if (i == 0) p4MapJet1_["Nano"] += p4Jet;
-            p4MapSelJetSum_["Nano"] += p4Jet;
-            p4SumAllNano_ += p4Jet;
-            
-            p4Met += p4Jet;//Add default p4Jet
-            
-            // Undo NanoAOD correction
-            undoNanoAODCorrection(*skimT, i);
-            p4Jet.SetPtEtaPhiM(skimT->Jet_pt[i], skimT->Jet_eta[i],
-                               skimT->Jet_phi[i], skimT->Jet_mass[i]);
-            if (i == 0) p4MapJet1_["Raw"] += p4Jet;
-            p4MapSelJetSum_["Raw"] += p4Jet;
-            
-            // Apply corrections based on level
-            if (level >= CorrectionLevel::L1Rc) {
-                applyL1FastJetCorrection(*skimT, i);
-                p4Jet.SetPtEtaPhiM(skimT->Jet_pt[i], skimT->Jet_eta[i],
-                                   skimT->Jet_phi[i], skimT->Jet_mass[i]);
-                if (i == 0) p4MapJet1_["L1RcCorr"] += p4Jet;
-                p4MapSelJetSum_["L1RcCorr"] += p4Jet;
-            }
-            
-            if (level >= CorrectionLevel::L2Rel) {
-                applyL2RelativeCorrection(*skimT, i);
-                p4Jet.SetPtEtaPhiM(skimT->Jet_pt[i], skimT->Jet_eta[i],
-                                   skimT->Jet_phi[i], skimT->Jet_mass[i]);
-                if (i == 0) p4MapJet1_["L2RelCorr"] += p4Jet;
-                p4MapSelJetSum_["L2RelCorr"] += p4Jet;
-            }
-            
-            if (level >= CorrectionLevel::L2L3Res && isData_) {
-                applyL2L3ResidualCorrection(*skimT, i);
-                p4Jet.SetPtEtaPhiM(skimT->Jet_pt[i], skimT->Jet_eta[i],
-                                   skimT->Jet_phi[i], skimT->Jet_mass[i]);
-                if (i == 0) p4MapJet1_["L2L3ResCorr"] += p4Jet;
-                p4MapSelJetSum_["L2L3ResCorr"] += p4Jet;
-            }
-            
-            if (applyJer_ && !isData_) {
-                applyJerCorrection(*skimT, i);
-                p4Jet.SetPtEtaPhiM(skimT->Jet_pt[i], skimT->Jet_eta[i],
-                                   skimT->Jet_phi[i], skimT->Jet_mass[i]);
-                if (i == 0) p4MapJet1_["JerCorr"] += p4Jet;
-                p4MapSelJetSum_["JerCorr"] += p4Jet;
-            }
-            
-            //Final correction
-            if (i == 0) p4MapJet1_["Corr"] += p4Jet;
-            p4MapSelJetSum_["Corr"] += p4Jet;
-            p4SumCorrAndUnCorr_ += p4Jet;
-            
-            p4Met -= p4Jet;//Subtract corrected p4Jet
-        }//if pT, eta
-        else{
-            p4Jet.SetPtEtaPhiM(skimT->Jet_pt[i], skimT->Jet_eta[i],
-                               skimT->Jet_phi[i], skimT->Jet_mass[i]);
+template <unsigned kMask>
+void ScaleJetMet::runChain(SkimTree& skimT) {
+    // JECs are not reliable for low pTs and high etas. It is better
+    // to skip such jets than applying unreliable JEC
+    gatherJets(skimT);
+    const std::size_t nSel = selIndex_.size();
+    hasStep_.fill(false);
+
+    // Undo NanoAOD correction
+    for (std::size_t k = 0; k < nSel; ++k) {
+        rawScale_[k] = 1.0f - skimT.Jet_rawFactor[selIndex_[k]];
+        pt_[k] *= rawScale_[k];
+    }
+
+    // One batched call per level; each level takes the pt after the previous one
+    if constexpr ((kMask & JetLevelChain::L1Rc) != 0) {
+        scaleObj_->getL1FastJetCorrections(nSel, area_.data(), eta_.data(), pt_.data(), skimT.Rho,
+                                           corrStep_[L1RcCorr].data());
+        applyStep(L1RcCorr);
+    }
+    if constexpr ((kMask & JetLevelChain::L2Rel) != 0) {
+        scaleObj_->getL2RelativeCorrections(nSel, eta_.data(), pt_.data(), corrStep_[L2RelCorr].data());
+        applyStep(L2RelCorr);
+    }
+    if constexpr ((kMask & JetLevelChain::L2L3Res) != 0) {
+        scaleObj_->getL2L3ResidualCorrections(nSel, eta_.data(), pt_.data(), corrStep_[L2L3ResCorr].data());
+        applyStep(L2L3ResCorr);
+    }
+    if constexpr ((kMask & JetLevelChain::Jer) != 0) {
+        scaleObj_->getJerCorrections(skimT, nSel, selIndex_.data(), eta_.data(), pt_.data(), phi_.data(),
+                                     genJetIdx_.data(), "nom", corrStep_[JerCorr].data());
+        applyStep(JerCorr);
+    }
+
+    sumJetsAndMet<kMask>(skimT);
+    sumLevels_ = &ScaleJetMet::sumLevelsOf<kMask>;
+}
+
+void ScaleJetMet::gatherJets(const SkimTree& skimT) {
+    selIndex_.clear();
+    eta_.clear(); phi_.clear(); area_.clear(); ptNano_.clear(); massNano_.clear(); genJetIdx_.clear();
+    for (int i = 0; i < skimT.nJet; ++i) {
+        if (!(skimT.Jet_pt[i] > 15 && std::abs(skimT.Jet_eta[i]) < 5.2)) continue;
+        selIndex_.push_back(i);
+        eta_.push_back(skimT.Jet_eta[i]);
+        phi_.push_back(skimT.Jet_phi[i]);
+        area_.push_back(skimT.Jet_area[i]);
+        ptNano_.push_back(skimT.Jet_pt[i]);
+        massNano_.push_back(skimT.Jet_mass[i]);
+        genJetIdx_.push_back(skimT.Jet_genJetIdx[i]);
+    }
+    const std::size_t nSel = selIndex_.size();
+    pt_.assign(ptNano_.begin(), ptNano_.end());
+    rawScale_.resize(nSel);
+    for (auto& corr : corrStep_) corr.resize(nSel);
+}
+
+void ScaleJetMet::applyStep(Level step) {
+    const std::vector<double>& corr = corrStep_[step];
+    for (std::size_t k = 0; k < pt_.size(); ++k) pt_[k] *= corr[k];
+    hasStep_[step] = true;
+}
+
+// pt and mass stay float between the levels, as Jet_pt/Jet_mass, so the
+// rounding is the same as scaling the NanoAOD arrays level by level
+template <unsigned kMask>
+void ScaleJetMet::sumJetsAndMet(SkimTree& skimT) {
+    const double* const corr[JetLevelChain::nSteps] = {
+        corrStep_[L1RcCorr].data(), corrStep_[L2RelCorr].data(), corrStep_[L2L3ResCorr].data(),
+        corrStep_[JerCorr].data()};
+    P4 p4Met = P4::fromPtEtaPhiM(skimT.ChsMET_pt, 0, skimT.ChsMET_phi, 0);
+    p4Met_[Nano] = p4Met;
+
+    const std::size_t nSel = selIndex_.size();
+    std::size_t k = 0;
+    for (int i = 0; i < skimT.nJet; ++i) {
+        if (!(k < nSel && selIndex_[k] == i)) {
+            const P4 p4Jet = P4::fromPtEtaPhiM(skimT.Jet_pt[i], skimT.Jet_eta[i],
+                                               skimT.Jet_phi[i], skimT.Jet_mass[i]);
             p4SumAllNano_ += p4Jet;
             p4SumCorrAndUnCorr_ += p4Jet;
+            continue;
         }
+        const double cosPhi = std::cos(static_cast<double>(phi_[k]));
+        const double sinPhi = std::sin(static_cast<double>(phi_[k]));
+        const double sinhEta = std::sinh(static_cast<double>(eta_[k]));
+
+        float pt = ptNano_[k];
+        float mass = massNano_[k];
+        const P4 p4Nano = P4::fromPtM(pt, cosPhi, sinPhi, sinhEta, mass);
+        if (i == 0) p4Jet1_[Nano] += p4Nano;
+        p4SelJetSum_[Nano] += p4Nano;
+        p4SumAllNano_ += p4Nano;
+        p4Met += p4Nano;//Add default p4Jet
+
+        pt *= rawScale_[k];
+        mass *= rawScale_[k];
+        JetLevelChain::advance<kMask>(pt, mass, corr, k);
+        const P4 p4Jet = P4::fromPtM(pt, cosPhi, sinPhi, sinhEta, mass);
+        //Final correction
+        if (i == 0) p4Jet1_[Corr] += p4Jet;
+        p4SelJetSum_[Corr] += p4Jet;
+        p4SumCorrAndUnCorr_ += p4Jet;
+        p4Met -= p4Jet;//Subtract corrected p4Jet
+
+        skimT.Jet_pt[i] = pt;
+        skimT.Jet_mass[i] = mass;
+        ++k;
     }//for nJet
     //Update the MET
-    p4MapMet_["Corr"] = p4Met;
-    skimT->ChsMET_pt  = p4Met.Pt(); 
-    skimT->ChsMET_phi = p4Met.Phi();
-}
-
-// Undo NanoAOD correction
-void ScaleJetMet::undoNanoAODCorrection(SkimTree& skimT, int i) {
-    float scale = 1.0f - skimT.Jet_rawFactor[i];
-    skimT.Jet_pt[i] *= scale;
-    skimT.Jet_mass[i] *= scale;
+    p4Met_[Corr] = p4Met;
+    skimT.ChsMET_pt  = p4Met.pt(); 
+    skimT.ChsMET_phi = p4Met.phi();
 }
 
-// L1 FastJet correction
-void ScaleJetMet::applyL1FastJetCorrection(SkimTree& skimT, int i) {
-    double corr = scaleObj_->getL1FastJetCorrection(skimT.Jet_area[i], skimT.Jet_eta[i],
-                                                    skimT.Jet_pt[i], skimT.Rho);
-    skimT.Jet_pt[i] *= corr;
-    skimT.Jet_mass[i] *= corr;
+void ScaleJetMet::sumLevels(Level level) const {
+    if (hasLevelSums_ || level == Nano || level == Corr || !sumLevels_) return;
+    hasLevelSums_ = true;
+    (this->*sumLevels_)();
 }
 
-// L2 Relative correction
-void ScaleJetMet::applyL2RelativeCorrection(SkimTree& skimT, int i) {
-    double corr = scaleObj_->getL2RelativeCorrection(skimT.Jet_eta[i], skimT.Jet_pt[i]);
-    skimT.Jet_pt[i] *= corr;
-    skimT.Jet_mass[i] *= corr;
+template <unsigned kMask>
+void ScaleJetMet::sumLevelsOf() const {
+    for (std::size_t k = 0; k < selIndex_.size(); ++k) {
+        const double cosPhi = std::cos(static_cast<double>(phi_[k]));
+        const double sinPhi = std::sin(static_cast<double>(phi_[k]));
+        const double sinhEta = std::sinh(static_cast<double>(eta_[k]));
+        auto record = [&](int level, float pt, float mass) {
+            const P4 p4Jet = P4::fromPtM(pt, cosPhi, sinPhi, sinhEta, mass);
+            if (selIndex_[k] == 0) p4Jet1_[level] += p4Jet;
+            p4SelJetSum_[level] += p4Jet;
+        };
+        float pt = ptNano_[k] * rawScale_[k];
+        float mass = massNano_[k] * rawScale_[k];
+        record(Raw, pt, mass);
+        auto step = [&](auto bit, int level) {
+            if constexpr ((kMask & decltype(bit)::value) != 0) {
+                pt *= corrStep_[level][k];
+                mass *= corrStep_[level][k];
+                record(level, pt, mass);
+            }
+        };
+        step(std::integral_constant<unsigned, JetLevelChain::L1Rc>{}, L1RcCorr);
+        step(std::integral_constant<unsigned, JetLevelChain::L2Rel>{}, L2RelCorr);
+        step(std::integral_constant<unsigned, JetLevelChain::L2L3Res>{}, L2L3ResCorr);
+        step(std::integral_constant<unsigned, JetLevelChain::Jer>{}, JerCorr);
+    }
 }
 
-// L2L3 Residual correction
-void ScaleJetMet::applyL2L3ResidualCorrection(SkimTree& skimT, int i) {
-    double corr = scaleObj_->getL2L3ResidualCorrection(skimT.Jet_eta[i], skimT.Jet_pt[i]);
-    skimT.Jet_pt[i] *= corr;
-    skimT.Jet_mass[i] *= corr;
-}
+// The level-by-level chain: scale all jets per level, then one P4 per jet and level
+void ScaleJetMet::validateSums(const SkimTree& skimT) const {
+    sumLevels(Raw);
+    const std::size_t nSel = selIndex_.size();
+    std::vector<float> pt(ptNano_), mass(massNano_);
+    std::array<P4, nLevels> jet1{}, jetSum{};
+    P4 met = p4Met_[Nano];
+    auto addStep = [&](int step) {
+        for (std::size_t k = 0; k < nSel; ++k) {
+            const P4 p4Jet = P4::fromPtEtaPhiM(pt[k], eta_[k], phi_[k], mass[k]);
+            if (selIndex_[k] == 0) jet1[step] += p4Jet;
+            jetSum[step] += p4Jet;
+            if (step == Nano) met += p4Jet;
+        }
+    };
+    addStep(Nano);
+    for (std::size_t k = 0; k < nSel; ++k) {
+        pt[k] *= rawScale_[k];
+        mass[k] *= rawScale_[k];
+    }
+    addStep(Raw);
+    int last = Raw;
+    for (int step = L1RcCorr; step < Corr; ++step) {
+        if (!hasStep_[step]) continue;
+        for (std::size_t k = 0; k < nSel; ++k) {
+            pt[k] *= corrStep_[step][k];
+            mass[k] *= corrStep_[step][k];
+        }
+        addStep(step);
+        last = step;
+    }
+    jet1[Corr] = jet1[last];
+    jetSum[Corr] = jetSum[last];
+    for (std::size_t k = 0; k < nSel; ++k) {
+        met -= P4::fromPtEtaPhiM(pt[k], eta_[k], phi_[k], mass[k]);
+    }
 
-// Jer correction
-void ScaleJetMet::applyJerCorrection(SkimTree& skimT, int i) {
-    double corr = scaleObj_->getJerCorrection(skimT, i, "nom");
-    skimT.Jet_pt[i] *= corr;
-    skimT.Jet_mass[i] *= corr;
+    auto differs = [](const P4& a, const P4& b) {
+        const double scale = std::max({1.0, std::abs(a.e), std::abs(b.e)});
+        return std::abs(a.px - b.px) > 1e-9 * scale || std::abs(a.py - b.py) > 1e-9 * scale ||
+               std::abs(a.pz - b.pz) > 1e-9 * scale || std::abs(a.e - b.e) > 1e-9 * scale;
+    };
+    for (int step = Nano; step < nLevels; ++step) {
+        if (differs(jet1[step], p4Jet1_[step]) || differs(jetSum[step], p4SelJetSum_[step])) {
+            throw std::runtime_error(std::string("ScaleJetMet: fused sums differ at ") + levelNames[step] +
+                                     " in event " + std::to_string(skimT.event));
+        }
+    }
+    if (differs(met, p4Met_[Corr])) {
+        throw std::runtime_error("ScaleJetMet: fused MET differs in event " + std::to_string(skimT.event));
+    }
 }
 
 // Print jet corrections
 void ScaleJetMet::print() const {
-    auto printCorrections = [](const std::unordered_map<std::string, TLorentzVector>& corrections, const std::string& header) {
+    auto printCorrections = [](const std::array<P4, nLevels>& corrections, const std::string& header, bool metOnly) {
         std::cout << header << '\n';
-        for (const auto& [label, p4] : corrections) {
-            std::cout << "  " << label << " Pt: " << p4.Pt() << ", Mass: " << p4.M() << '\n';
+        for (int level = Nano; level < nLevels; ++level) {
+            if (metOnly && level != Nano && level != Corr) continue;
+            const P4& p4 = corrections[level];
+            std::cout << "  " << levelNames[level] << " Pt: " << p4.pt() << ", Mass: " << p4.m() << '\n';
         }
         std::cout << '\n';
     };
 
+    sumLevels(Raw);
     std::cout << std::fixed << std::setprecision(3);
-    printCorrections(p4MapJet1_, "Jet1 Corrections:");
-    printCorrections(p4MapSelJetSum_, "JetSum Corrections:");
-    printCorrections(p4MapMet_, "Met Corrections:");
+    printCorrections(p4Jet1_, "Jet1 Corrections:", false);
+    printCorrections(p4SelJetSum_, "JetSum Corrections:", false);
+    printCorrections(p4Met_, "Met Corrections:", true);
     std::cout<<"Check momentum conservation, (p4Met - p4AllJet).Pt(): "<<'\n';
-    std::cout<<"    At Nano   : "<<(p4MapMet_.at("Nano") - p4SumAllNano_).Pt()<<'\n';
-    std::cout<<"    After JEC : "<<(p4MapMet_.at("Corr") - p4SumCorrAndUnCorr_).Pt()<<'\n';
+    std::cout<<"    At Nano   : "<<(p4Met_[Nano] - p4SumAllNano_).pt()<<'\n';
+    std::cout<<"    After JEC : "<<(p4Met_[Corr] - p4SumCorrAndUnCorr_).pt()<<'\n';
 }
-
@@ -28,15 +28,16 @@ void ScaleMuon::applyCorrections(std::shared_ptr<SkimTree>& skimT) {
 
     Initialize();
 
+    double corrs[SkimTree::nMuonMax];
+    scaleObj_->getMuRochCorrections(*skimT, corrs);
+
     TLorentzVector p4Muon;
     for (int j = 0; j < skimT->nMuon; ++j) {
         p4Muon.SetPtEtaPhiM(skimT->Muon_pt[j], skimT->Muon_eta[j], 
                             skimT->Muon_phi[j], skimT->Muon_mass[j]);
         if(j==0) p4MapMuon1_["Nano"] = p4Muon;
         
-        double corr = 1.0;
-        corr = scaleObj_->getMuRochCorrection(*skimT, j, "nom");
-        skimT->Muon_pt[j] *= corr;
+        skimT->Muon_pt[j] *= corrs[j];
         p4Muon.SetPtEtaPhiM(skimT->Muon_pt[j], skimT->Muon_eta[j], 
                             skimT->Muon_phi[j], skimT->Muon_mass[j]);
         if(j==0) p4MapMuon1_["Corr"] = p4Muon;
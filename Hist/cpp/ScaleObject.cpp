@@ -1,7 +1,11 @@
 #include "ScaleObject.h"
+#include "CorrectionRegistry.h"
 #include "Helper.h"
+#include "CounterRng.h"
+#include "EgmSsKernel.h"
 #include <iostream>
 #include <stdexcept>
+#include <tuple>
 #include <ReadConfig.h>
 
 ScaleObject::ScaleObject(GlobalFlag& globalFlags)
@@ -32,6 +36,12 @@ void ScaleObject::loadConfig(const std::string& filename) {
     eleSsJsonPath_         = config.getValue<std::string>({yearStr, "eleSsJsonPath"});
     eleSsName_             = config.getValue<std::string>({yearStr, "eleSsName"});
 
+    useJercGrid_                 = config.getValue<bool>({"jercGrid", "use"});
+    jercGridOptions_.nPtPoints   = config.getValue<int>({"jercGrid", "nPtPoints"});
+    jercGridOptions_.ptMin       = config.getValue<double>({"jercGrid", "ptMin"});
+    jercGridOptions_.ptMax       = config.getValue<double>({"jercGrid", "ptMax"});
+    nJercGridValidate_           = config.getValue<int>({"jercGrid", "nValidatePoints"});
+
     // If running on data, override with data-specific settings if available.
     if (isMC_){
         jetL1FastJetName_      = config.getValue<std::string>({yearStr, "jetL1FastJetName"});
@@ -74,13 +84,86 @@ void ScaleObject::loadConfig(const std::string& filename) {
     std::cout << "muRochJsonPath         = " << muRochJsonPath_ << '\n' << '\n';
     std::cout << "eleSsJsonPath          = " << eleSsJsonPath_ << '\n';
     std::cout << "eleSsName              = " << eleSsName_ << '\n' << '\n';
+    std::cout << "useJercGrid            = " << useJercGrid_ << '\n' << '\n';
+}
+
+void ScaleObject::setCorrectionCache(const std::shared_ptr<const CorrectionCache>& cache) {
+  cache_ = cache;
+}
+
+// From the mapped cache if it has the correction, else from jercJsonPath_
+auto ScaleObject::loadJercCorrection(const std::string& name) const -> correction::Correction::Ref {
+  if (cache_ && cache_->has("corr/" + name)) {
+    return CorrectionRegistry::getInstance().getCorrection(*cache_, name);
+  }
+  return CorrectionRegistry::getInstance().getCorrection(jercJsonPath_, name);
+}
+
+// Tabulate a loaded correction
+auto ScaleObject::makeJercGrid(const correction::Correction::Ref& ref, const std::string& name,
+                               const std::string& category) const -> std::unique_ptr<JercGrid> {
+  const std::string prefix = "grid/" + name;
+  if (cache_ && JercGrid::isCached(*cache_, prefix, jercGridOptions_, category)) {
+    return JercGrid::fromCache(cache_, prefix, ref);
+  }
+  if (cache_ && cache_->has(prefix + "/values")) {
+    std::cout << "Warning: " << prefix << " in " << cache_->getPath()
+              << " was built with other jercGrid options, rebuilding it" << '\n';
+  }
+  const auto& correctionJson = CorrectionRegistry::getInstance().getCorrectionJson(jercJsonPath_, name);
+  return std::make_unique<JercGrid>(ref, correctionJson, jercGridOptions_, category);
+}
+
+// Returns nullptr when the grid is switched off
+auto ScaleObject::buildJercGrid(const correction::Correction::Ref& ref, const std::string& name,
+                                const std::string& category) const -> std::unique_ptr<JercGrid> {
+  if (!useJercGrid_) return nullptr;
+  auto grid = makeJercGrid(ref, name, category);
+  if (nJercGridValidate_ > 0) {
+    grid->validate(nJercGridValidate_);
+  }
+  return grid;
+}
+
+// All loaded JERC corrections, and their grids (built here if switched off), and the Rochester table
+void ScaleObject::writeCorrectionCache(CorrectionCacheWriter& writer) const {
+  std::cout << "==> ScaleObject::writeCorrectionCache()" << '\n';
+  auto& registry = CorrectionRegistry::getInstance();
+  const std::vector<std::pair<std::string, correction::Correction::Ref>> loaded = {
+      {jetL1FastJetName_, loadedJetL1FastJetRef_},
+      {jetL2RelativeName_, loadedJetL2RelativeRef_},
+      {jetL2L3ResidualName_, loadedJetL2L3ResidualRef_},
+      {JerResoName_, loadedJerResoRef_},
+      {JerSfName_, loadedJerSfRef_}};
+  for (const auto& [name, ref] : loaded) {
+    if (!ref) continue;
+    writer.addText("corr/" + name, registry.getStandaloneJson(jercJsonPath_, name));
+  }
+  const std::vector<std::tuple<std::string, correction::Correction::Ref, const JercGrid*, std::string>> grids = {
+      {jetL2RelativeName_, loadedJetL2RelativeRef_, jetL2RelativeGrid_.get(), ""},
+      {jetL2L3ResidualName_, loadedJetL2L3ResidualRef_, jetL2L3ResidualGrid_.get(), ""},
+      {JerResoName_, loadedJerResoRef_, jerResoGrid_.get(), ""},
+      {JerSfName_, loadedJerSfRef_, jerSfGrid_.get(), "nom"}};
+  for (const auto& [name, ref, grid, category] : grids) {
+    if (!ref) continue;
+    if (grid) {
+      grid->writeTo(writer, "grid/" + name);
+    } else {
+      makeJercGrid(ref, name, category)->writeTo(writer, "grid/" + name);
+    }
+  }
+  writer.addSource(jercJsonPath_);
+  if (rochTable_) {
+    rochTable_->writeTo(writer, "roch/" + muRochJsonPath_);
+    writer.addSource(muRochJsonPath_);
+  }
 }
 
 
 void ScaleObject::loadJetL1FastJetRef() {
   std::cout << "==> loadJetL1FastJetRef()" << '\n';
   try {
-    loadedJetL1FastJetRef_ = correction::CorrectionSet::from_file(jercJsonPath_)->at(jetL1FastJetName_);
+    loadedJetL1FastJetRef_ = loadJercCorrection(jetL1FastJetName_);
   } catch (const std::exception &e) {
     std::cerr << "\nEXCEPTION: ScaleObject::loadJetL1FastJetRef" << '\n';
     std::cerr << "Check " << jercJsonPath_ << " or " << jetL1FastJetName_ << '\n';
@@ -111,7 +194,8 @@ auto ScaleObject::getL1FastJetCorrection(double jetArea, double jetEta, double j
 void ScaleObject::loadJetL2RelativeRef() {
   std::cout << "==> loadJetL2RelativeRef()" << '\n';
   try {
-    loadedJetL2RelativeRef_ = correction::CorrectionSet::from_file(jercJsonPath_)->at(jetL2RelativeName_);
+    loadedJetL2RelativeRef_ = loadJercCorrection(jetL2RelativeName_);
+    jetL2RelativeGrid_ = buildJercGrid(loadedJetL2RelativeRef_, jetL2RelativeName_);
   } catch (const std::exception &e) {
     std::cerr << "\nEXCEPTION: ScaleObject::loadJetL2RelativeRef" << '\n';
     std::cerr << "Check " << jercJsonPath_ << " or " << jetL2RelativeName_ << '\n';
@@ -123,7 +207,8 @@ void ScaleObject::loadJetL2RelativeRef() {
 auto ScaleObject::getL2RelativeCorrection(double jetEta, double jetPt) const -> double {
   double corrL2Relative = 1.0;
   try {
-    corrL2Relative = loadedJetL2RelativeRef_->evaluate({jetEta, jetPt});
+    corrL2Relative = jetL2RelativeGrid_ ? jetL2RelativeGrid_->evaluate(jetEta, jetPt)
+                                        : loadedJetL2RelativeRef_->evaluate({jetEta, jetPt});
     if (isDebug_) {std::cout 
             << "jetEta= " << jetEta
             << ", jetPt= " << jetPt
@@ -140,7 +225,8 @@ auto ScaleObject::getL2RelativeCorrection(double jetEta, double jetPt) const ->
 void ScaleObject::loadJetL2L3ResidualRef() {
   std::cout << "==> loadJetL2L3ResidualRef()" << '\n';
   try {
-    loadedJetL2L3ResidualRef_ = correction::CorrectionSet::from_file(jercJsonPath_)->at(jetL2L3ResidualName_);
+    loadedJetL2L3ResidualRef_ = loadJercCorrection(jetL2L3ResidualName_);
+    jetL2L3ResidualGrid_ = buildJercGrid(loadedJetL2L3ResidualRef_, jetL2L3ResidualName_);
   } catch (const std::exception &e) {
     std::cerr << "\nEXCEPTION: ScaleObject::loadJetL2L3ResidualRef" << '\n';
     std::cerr << "Check " << jercJsonPath_ << " or " << jetL2L3ResidualName_ << '\n';
@@ -152,7 +238,8 @@ void ScaleObject::loadJetL2L3ResidualRef() {
 auto ScaleObject::getL2L3ResidualCorrection(double jetEta, double jetPt) const -> double {
   double corrL2L3Residual = 1.0;
   try {
-    corrL2L3Residual = loadedJetL2L3ResidualRef_->evaluate({jetEta, jetPt});
+    corrL2L3Residual = jetL2L3ResidualGrid_ ? jetL2L3ResidualGrid_->evaluate(jetEta, jetPt)
+                                            : loadedJetL2L3ResidualRef_->evaluate({jetEta, jetPt});
     if (isDebug_) {std::cout 
             << ", jetEta= " << jetEta
             << ", jetPt= " << jetPt
@@ -170,7 +257,8 @@ auto ScaleObject::getL2L3ResidualCorrection(double jetEta, double jetPt) const -
 void ScaleObject::loadJerResoRef() {
   std::cout << "==> loadJerResoRef()" << '\n';
   try {
-    loadedJerResoRef_ = correction::CorrectionSet::from_file(jercJsonPath_)->at(JerResoName_);
+    loadedJerResoRef_ = loadJercCorrection(JerResoName_);
+    jerResoGrid_ = buildJercGrid(loadedJerResoRef_, JerResoName_);
   } catch (const std::exception &e) {
     std::cout << "\nEXCEPTION: ScaleObject::loadJerResoRef" << '\n';
     std::cout << "Check " << jercJsonPath_ << " or " << JerResoName_ << '\n';
@@ -182,7 +270,8 @@ void ScaleObject::loadJerResoRef() {
 auto ScaleObject::getJerResolution(const SkimTree& skimT, int index) const -> double {
   double JerReso = 1.0;
   try {
-    JerReso = loadedJerResoRef_->evaluate({skimT.Jet_eta[index], skimT.Jet_pt[index], skimT.Rho});
+    JerReso = jerResoGrid_ ? jerResoGrid_->evaluate(skimT.Jet_eta[index], skimT.Jet_pt[index], skimT.Rho)
+                           : loadedJerResoRef_->evaluate({skimT.Jet_eta[index], skimT.Jet_pt[index], skimT.Rho});
     if (isDebug_) std::cout 
                 << ", jetEta= " << skimT.Jet_eta[index]
                 << ", jetPt= " << skimT.Jet_pt[index]
@@ -199,7 +288,8 @@ auto ScaleObject::getJerResolution(const SkimTree& skimT, int index) const -> do
 void ScaleObject::loadJerSfRef() {
   std::cout << "==> loadJerSfRef()" << '\n';
   try {
-    loadedJerSfRef_ = correction::CorrectionSet::from_file(jercJsonPath_)->at(JerSfName_);
+    loadedJerSfRef_ = loadJercCorrection(JerSfName_);
+    jerSfGrid_ = buildJercGrid(loadedJerSfRef_, JerSfName_, "nom");
   } catch (const std::exception &e) {
     std::cout << "\nEXCEPTION: ScaleObject::loadJerSfRef" << '\n';
     std::cout << "Check " << jercJsonPath_ << " or " << JerSfName_ << '\n';
@@ -211,7 +301,8 @@ void ScaleObject::loadJerSfRef() {
 auto ScaleObject::getJerScaleFactor(const SkimTree& skimT, int index, const std::string &syst) const -> double {
   double JerSf = 1.0;
   try {
-    JerSf = loadedJerSfRef_->evaluate({skimT.Jet_eta[index], syst});
+    JerSf = (jerSfGrid_ && syst == jerSfGrid_->getCategory()) ? jerSfGrid_->evaluate(skimT.Jet_eta[index], 0.0)
+                                                              : loadedJerSfRef_->evaluate({skimT.Jet_eta[index], syst});
     if (isDebug_) std::cout 
                 << ", jeteta= " << skimT.Jet_eta[index]
                 << ", syst  = " << syst
@@ -235,7 +326,6 @@ auto ScaleObject::getJerCorrection(const SkimTree& skimT, int index, const std::
   double pt = skimT.Jet_pt[index];
   double phi = skimT.Jet_phi[index];
   int genIdx = skimT.Jet_genJetIdx[index];
-  randomNumGen->SetSeed(skimT.event + skimT.run + skimT.luminosityBlock);
   bool isMatch = false;
   if ((genIdx > -1) && (genIdx < skimT.nGenJet)) {
     double delR = Helper::DELTAR(phi, skimT.GenJet_phi[genIdx], eta, skimT.GenJet_eta[genIdx]);
@@ -246,7 +336,9 @@ auto ScaleObject::getJerCorrection(const SkimTree& skimT, int index, const std::
   if (isMatch) { // scaling method
     corrJer = std::max(0.0, 1. + (sfJer - 1.) * (pt - skimT.GenJet_pt[genIdx]) / pt);
   } else { // stochastic smearing
-    corrJer = std::max(0.0, 1 + randomNumGen->Gaus(0, resoJer) * sqrt(std::max(sfJer * sfJer - 1, 0.)));
+    const double gaus = CounterRng::gaus(resoJer, skimT.run, skimT.luminosityBlock, skimT.event, index,
+                                         CounterRng::Purpose::JerSmear);
+    corrJer = std::max(0.0, 1 + gaus * sqrt(std::max(sfJer * sfJer - 1, 0.)));
     if (isDebug_) {std::cout 
                 << "Resolution = " 
                 << resoJer << ", sfJer = " 
@@ -258,13 +350,137 @@ auto ScaleObject::getJerCorrection(const SkimTree& skimT, int index, const std::
   return corrJer;
 }
 
+//-------------------------------------
+// Batched JEC/JER over the jets of one event
+//-------------------------------------
+void ScaleObject::getL1FastJetCorrections(std::size_t n, const float* jetArea, const float* jetEta,
+                                          const float* jetPt, double rho, double* corr) const {
+  try {
+    // One argument vector for all jets, only the values change
+    std::vector<correction::Variable::Type> args{0.0, 0.0, 0.0, rho};
+    for (std::size_t i = 0; i < n; ++i) {
+      args[0] = static_cast<double>(jetArea[i]);
+      args[1] = static_cast<double>(jetEta[i]);
+      args[2] = static_cast<double>(jetPt[i]);
+      corr[i] = loadedJetL1FastJetRef_->evaluate(args);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "\nEXCEPTION: in getL1FastJetCorrections(): " << e.what() << '\n';
+    throw std::runtime_error("Failed to get L1 Fast Jet Correction");
+  }
+  if (isDebug_) {
+    for (std::size_t i = 0; i < n; ++i) {
+      std::cout << "jetArea = " << jetArea[i] << ", jetEta= " << jetEta[i] << ", jetPt= " << jetPt[i]
+                << ", rho = " << rho << ", corrL1FastJet = " << corr[i] << '\n';
+    }
+  }
+}
+
+// L2Relative and L2L3Residual take the same inputs
+static void evaluateEtaPt(const JercGrid* grid, const correction::Correction::Ref& ref, std::size_t n,
+                          const float* jetEta, const float* jetPt, double* corr) {
+  if (grid) {
+    grid->evaluate(n, jetEta, jetPt, nullptr, corr);
+    return;
+  }
+  std::vector<correction::Variable::Type> args{0.0, 0.0};
+  for (std::size_t i = 0; i < n; ++i) {
+    args[0] = static_cast<double>(jetEta[i]);
+    args[1] = static_cast<double>(jetPt[i]);
+    corr[i] = ref->evaluate(args);
+  }
+}
+
+void ScaleObject::getL2RelativeCorrections(std::size_t n, const float* jetEta, const float* jetPt, double* corr) const {
+  try {
+    evaluateEtaPt(jetL2RelativeGrid_.get(), loadedJetL2RelativeRef_, n, jetEta, jetPt, corr);
+  } catch (const std::exception &e) {
+    std::cerr << "\nEXCEPTION: in getL2RelativeCorrections(): " << e.what() << '\n';
+    throw std::runtime_error("Failed to get L2 Relative Correction");
+  }
+  if (isDebug_) {
+    for (std::size_t i = 0; i < n; ++i) {
+      std::cout << "jetEta= " << jetEta[i] << ", jetPt= " << jetPt[i] << ", corrL2Relative = " << corr[i] << '\n';
+    }
+  }
+}
+
+void ScaleObject::getL2L3ResidualCorrections(std::size_t n, const float* jetEta, const float* jetPt, double* corr) const {
+  try {
+    evaluateEtaPt(jetL2L3ResidualGrid_.get(), loadedJetL2L3ResidualRef_, n, jetEta, jetPt, corr);
+  } catch (const std::exception &e) {
+    std::cerr << "\nEXCEPTION: in getL2L3ResidualCorrections(): " << e.what() << '\n';
+    throw std::runtime_error("Failed to get L2 L3 Residual Correction");
+  }
+  if (isDebug_) {
+    for (std::size_t i = 0; i < n; ++i) {
+      std::cout << ", jetEta= " << jetEta[i] << ", jetPt= " << jetPt[i] << ", corrL2L3Residual = " << corr[i] << '\n';
+    }
+  }
+}
+
+// Same smearing as getJerCorrection()
+void ScaleObject::getJerCorrections(const SkimTree& skimT, std::size_t n, const int* jetIndex, const float* jetEta,
+                                    const float* jetPt, const float* jetPhi, const Short_t* genJetIdx,
+                                    const std::string& syst, double* corr) const {
+  std::vector<double> resoJer(n);
+  std::vector<double> sfJer(n);
+  try {
+    const bool useSfGrid = jerSfGrid_ && syst == jerSfGrid_->getCategory();
+    std::vector<correction::Variable::Type> resoArgs{0.0, 0.0, static_cast<double>(skimT.Rho)};
+    std::vector<correction::Variable::Type> sfArgs{0.0, syst};
+    for (std::size_t i = 0; i < n; ++i) {
+      if (jerResoGrid_) {
+        resoJer[i] = jerResoGrid_->evaluate(jetEta[i], jetPt[i], skimT.Rho);
+      } else {
+        resoArgs[0] = static_cast<double>(jetEta[i]);
+        resoArgs[1] = static_cast<double>(jetPt[i]);
+        resoJer[i] = loadedJerResoRef_->evaluate(resoArgs);
+      }
+      if (useSfGrid) {
+        sfJer[i] = jerSfGrid_->evaluate(jetEta[i], 0.0);
+      } else {
+        sfArgs[0] = static_cast<double>(jetEta[i]);
+        sfJer[i] = loadedJerSfRef_->evaluate(sfArgs);
+      }
+    }
+  } catch (const std::exception &e) {
+    std::cout << "\nEXCEPTION: in getJerCorrections(): " << e.what() << '\n';
+    throw std::runtime_error("Error calculating Jer Correction.");
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const double eta = jetEta[i];
+    const double pt = jetPt[i];
+    const int genIdx = genJetIdx[i];
+    bool isMatch = false;
+    if ((genIdx > -1) && (genIdx < skimT.nGenJet)) {
+      double delR = Helper::DELTAR(jetPhi[i], skimT.GenJet_phi[genIdx], eta, skimT.GenJet_eta[genIdx]);
+      if (delR < 0.2 && std::abs(pt - skimT.GenJet_pt[genIdx]) < 3 * resoJer[i] * pt) {
+        isMatch = true;
+      }
+    }
+    if (isMatch) { // scaling method
+      corr[i] = std::max(0.0, 1. + (sfJer[i] - 1.) * (pt - skimT.GenJet_pt[genIdx]) / pt);
+    } else { // stochastic smearing
+      const double gaus = CounterRng::gaus(resoJer[i], skimT.run, skimT.luminosityBlock, skimT.event, jetIndex[i],
+                                           CounterRng::Purpose::JerSmear);
+      corr[i] = std::max(0.0, 1 + gaus * sqrt(std::max(sfJer[i] * sfJer[i] - 1, 0.)));
+    }
+    if (isDebug_) {
+      std::cout << "jetEta= " << eta << ", jetPt= " << pt << ", Resolution = " << resoJer[i]
+                << ", sfJer = " << sfJer[i] << ", corrJer = " << corr[i] << '\n';
+    }
+  }
+}
+
 //-------------------------------------
 // Photon Scale and Smearing
 //-------------------------------------
 void ScaleObject::loadPhoSsRef() {
   std::cout << "==> loadPhoSsRef()" << '\n';
   try {
-    loadedPhoSsRef_ = correction::CorrectionSet::from_file(phoSsJsonPath_)->at(phoSsName_);
+    loadedPhoSsRef_ = CorrectionRegistry::getInstance().getCorrection(phoSsJsonPath_, phoSsName_);
   } catch (const std::exception &e) {
     std::cout << "\nEXCEPTION: ScaleObject::loadPhoSsRef()" << '\n';
     std::cout << "Check " << phoSsJsonPath_ << " or " << phoSsName_ << '\n';
@@ -321,12 +537,37 @@ auto ScaleObject::getPhoSmearCorrection(const SkimTree& skimT, const std::string
   return phoSmearSf;
 }
 
+void ScaleObject::getPhoScaleCorrections(const SkimTree& skimT, const std::string &nomOrSyst, double* corr) const {
+  try {
+    EgmSsKernel::phoScaleCorrections(*loadedPhoSsRef_, nomOrSyst, skimT.run, skimT.nPhoton, skimT.Photon_seedGain,
+                                     skimT.Photon_eta, skimT.Photon_r9, skimT.Photon_pt, corr);
+  } catch (const std::exception &e) {
+    std::cout << "\nEXCEPTION: in ScaleObject::getPhoScaleCorrections(): " << e.what() << '\n';
+    throw std::runtime_error("Error calculating Photon Scale Correction.");
+  }
+}
+
+void ScaleObject::getPhoSmearCorrections(const SkimTree& skimT, const std::string &nomOrSyst, double* corr) const {
+  try {
+    EgmSsKernel::phoSmearCorrections(*loadedPhoSsRef_, nomOrSyst, skimT.nPhoton, skimT.Photon_eta, skimT.Photon_r9,
+                                     corr);
+  } catch (const std::exception &e) {
+    std::cout << "\nEXCEPTION: in ScaleObject::getPhoSmearCorrections(): " << e.what() << '\n';
+    throw std::runtime_error("Error calculating Photon Smear Correction.");
+  }
+}
+
 //-------------------------------------
 // Muon Roch Correction
 //-------------------------------------
 void ScaleObject::loadMuRochRef() {
   std::cout << "==> loadMuRochRef()" << '\n';
+  const std::string prefix = "roch/" + muRochJsonPath_;
   try {
+    if (cache_ && cache_->has(prefix + "/meta")) {
+      rochTable_ = RoccoRTable::fromCache(cache_, prefix);
+      return;
+    }
     loadedRochRef_.init(muRochJsonPath_);
   } catch (const std::exception &e) {
     std::cout << "\nEXCEPTION: ScaleObject::loadMuRochRef()" << '\n';
@@ -334,7 +575,27 @@ void ScaleObject::loadMuRochRef() {
     std::cout << e.what() << '\n';
     throw std::runtime_error("Error loading muon rochester corr file.");
   }
+  try {
+    rochTable_ = std::make_unique<RoccoRTable>(loadedRochRef_);
+    rochTable_->validate(loadedRochRef_, 10000);
+  } catch (const std::exception &e) {
+    std::cout << "Warning: " << e.what() << ", using RoccoR directly" << '\n';
+    rochTable_.reset();
+  }
+}
+
+// Generator pt of the dressed muon within dR < 0.2, or -9999 if none
+auto ScaleObject::getMuRochGenPt(const SkimTree& skimT, int index) const -> double {
+    for (int i = 0; i < skimT.nGenDressedLepton; ++i) {
+        if (std::abs(skimT.GenDressedLepton_pdgId[i]) == 13) {
+            double delR = Helper::DELTAR(skimT.Muon_phi[index], skimT.GenDressedLepton_phi[i],
+                                         skimT.Muon_eta[index], skimT.GenDressedLepton_eta[i]);
+            if(delR < 0.2) return skimT.GenDressedLepton_pt[i];
+        }//PDG
+    }//for nGen
+    return -9999.;
 }
+
 //
 auto ScaleObject::getMuRochCorrection(const SkimTree& skimT, int index, const std::string &syst) const -> double {
     double corrMuRoch = 1.0;
@@ -350,27 +611,22 @@ auto ScaleObject::getMuRochCorrection(const SkimTree& skimT, int index, const st
     bool isMatched = false;
     
     if(isData_){
-        corrMuRoch = loadedRochRef_.kScaleDT(Q, pt, eta, phi, s, m); 
+        corrMuRoch = rochTable_ ? rochTable_->kScaleDT(Q, pt, eta, phi)
+                                : loadedRochRef_.kScaleDT(Q, pt, eta, phi, s, m); 
     }
     if(isMC_){
-        for (int i = 0; i < skimT.nGenDressedLepton; ++i) {
-            if (std::abs(skimT.GenDressedLepton_pdgId[i]) == 13) {
-                double delR = Helper::DELTAR(phi, skimT.GenDressedLepton_phi[i], eta, skimT.GenDressedLepton_eta[i]);
-                if(delR < 0.2){
-                    genPt = skimT.GenDressedLepton_pt[i];
-                    isMatched = true;
-                    break;
-                }
-            }//PDG
-        }//for nGen
+        genPt = getMuRochGenPt(skimT, index);
+        isMatched = genPt >= 0;
         if(isMatched){
-            corrMuRoch = loadedRochRef_.kSpreadMC(Q, pt, eta, phi, genPt, s, m);
+            corrMuRoch = rochTable_ ? rochTable_->kSpreadMC(Q, pt, eta, phi, genPt)
+                                    : loadedRochRef_.kSpreadMC(Q, pt, eta, phi, genPt, s, m);
         }
         else{
-            randomNumGen->SetSeed(skimT.event + skimT.run + skimT.luminosityBlock);
-            u = randomNumGen->Uniform(0.0, 1.0);
+            u = CounterRng::uniform(skimT.run, skimT.luminosityBlock, skimT.event, index,
+                                    CounterRng::Purpose::MuRochSmear);
             nl = skimT.Muon_nTrackerLayers[index];
-            corrMuRoch = loadedRochRef_.kSmearMC(Q, pt, eta, phi, nl, u, s, m);
+            corrMuRoch = rochTable_ ? rochTable_->kSmearMC(Q, pt, eta, phi, nl, u)
+                                    : loadedRochRef_.kSmearMC(Q, pt, eta, phi, nl, u, s, m);
         }
     }//isMC
     if (isDebug_) std::cout 
@@ -389,13 +645,61 @@ auto ScaleObject::getMuRochCorrection(const SkimTree& skimT, int index, const st
    return corrMuRoch; 
 }
 
+// Data in one call; MC split into gen-matched (spread) and unmatched (smear) muons
+void ScaleObject::getMuRochCorrections(const SkimTree& skimT, double* corr) const {
+    const int n = skimT.nMuon;
+    if (!rochTable_ || isDebug_) {
+        for (int j = 0; j < n; ++j) corr[j] = getMuRochCorrection(skimT, j, "nom");
+        return;
+    }
+    if (isData_) {
+        rochTable_->kScaleDT(n, skimT.Muon_charge, skimT.Muon_pt, skimT.Muon_eta, skimT.Muon_phi, corr);
+        return;
+    }
+    constexpr int nMax = SkimTree::nMuonMax;
+    int spreadIdx[nMax], smearIdx[nMax], nSpread = 0, nSmear = 0;
+    int Q[nMax], nl[nMax];
+    float pt[nMax], eta[nMax], phi[nMax];
+    double aux[nMax], out[nMax];
+    for (int j = 0; j < n; ++j) {
+        const double genPt = getMuRochGenPt(skimT, j);
+        if (genPt >= 0) {
+            spreadIdx[nSpread] = j;
+            aux[nSpread++] = genPt;
+        } else {
+            smearIdx[nSmear++] = j;
+        }
+    }
+    auto gather = [&](const int* idx, int m) {
+        for (int i = 0; i < m; ++i) {
+            const int j = idx[i];
+            Q[i] = skimT.Muon_charge[j];
+            pt[i] = skimT.Muon_pt[j];
+            eta[i] = skimT.Muon_eta[j];
+            phi[i] = skimT.Muon_phi[j];
+            nl[i] = skimT.Muon_nTrackerLayers[j];
+        }
+    };
+    gather(spreadIdx, nSpread);
+    rochTable_->kSpreadMC(nSpread, Q, pt, eta, phi, aux, out);
+    for (int i = 0; i < nSpread; ++i) corr[spreadIdx[i]] = out[i];
+
+    gather(smearIdx, nSmear);
+    for (int i = 0; i < nSmear; ++i) {
+        aux[i] = CounterRng::uniform(skimT.run, skimT.luminosityBlock, skimT.event, smearIdx[i],
+                                     CounterRng::Purpose::MuRochSmear);
+    }
+    rochTable_->kSmearMC(nSmear, Q, pt, eta, phi, nl, aux, out);
+    for (int i = 0; i < nSmear; ++i) corr[smearIdx[i]] = out[i];
+}
+
 //-------------------------------------
 // Electron Scale and Smearing
 //-------------------------------------
 void ScaleObject::loadEleSsRef() {
   std::cout << "==> loadEleSsRef()" << '\n';
   try {
-    loadedEleSsRef_ = correction::CorrectionSet::from_file(eleSsJsonPath_)->at(eleSsName_);
+    loadedEleSsRef_ = CorrectionRegistry::getInstance().getCorrection(eleSsJsonPath_, eleSsName_);
   } catch (const std::exception &e) {
     std::cout << "\nEXCEPTION: ScaleObject::loadEleSsRef()" << '\n';
     std::cout << "Check " << eleSsJsonPath_ << " or " << eleSsName_ << '\n';
@@ -404,27 +708,23 @@ void ScaleObject::loadEleSsRef() {
   }
 }
 auto ScaleObject::getEleSsCorrection(const SkimTree& skimT, int index, const std::string &syst) const -> double {
-    double corrEleSs = 1.0;
     double pt   = skimT.Electron_pt[index];
     double eta  = skimT.Electron_eta[index];
     double mass = skimT.Electron_mass[index];
-
-    // Calculate energy from pt, eta, and mass
-    double energy = std::sqrt(std::pow(pt * std::cosh(eta), 2) + std::pow(mass, 2));
-    double corrE = skimT.Electron_eCorr[index] * energy;
-
-    // Convert corrected energy back to new pT
-    double newPt = std::sqrt((std::pow(corrE, 2) - std::pow(mass, 2)) / std::pow(std::cosh(eta), 2));
-    corrEleSs = newPt/pt;
+    double corrEleSs = EgmSsKernel::eleSsCorrection(pt, eta, mass, skimT.Electron_eCorr[index]);
 
     if (isDebug_) std::cout 
                 << ", pt = " << pt
                 << ", eta = " << eta
-                << ", energy = " << energy
+                << ", mass = " << mass
                 << ", eCorr = " << skimT.Electron_eCorr[index]
-                << ", newPt = " << newPt
                 << ", corrEleSs = " << corrEleSs
                 << '\n';
    return corrEleSs; 
 }
 
+void ScaleObject::getEleSsCorrections(const SkimTree& skimT, double* corr) const {
+    EgmSsKernel::eleSsCorrections(skimT.nElectron, skimT.Electron_pt, skimT.Electron_eta, skimT.Electron_mass,
+                                  skimT.Electron_eCorr, corr);
+}
+
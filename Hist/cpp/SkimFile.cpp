@@ -3,10 +3,18 @@
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <numeric>
+#include <filesystem>
+#include <cstdio>
+#include <unistd.h>
+#include <TFile.h>
+#include <TTree.h>
 #include "SkimFile.h"
+#include "SkimTree.h"
 #include "Helper.h"
 
-SkimFile::SkimFile(GlobalFlag& globalFlags, const std::string& outName, const std::string& inJsonDir)
+SkimFile::SkimFile(GlobalFlag& globalFlags, const std::string& outName, const std::string& inJsonDir,
+                   bool splitByFiles, bool isNanoInput)
     : outName_(outName),
       globalFlags_(globalFlags),
       year_(globalFlags_.getYear()),
@@ -20,7 +28,12 @@ SkimFile::SkimFile(GlobalFlag& globalFlags, const std::string& outName, const st
     loadInput();
     setInputJsonPath(inJsonDir);
     loadInputJson();
-    loadJobFileNames();
+    if (isNanoInput) {
+        loadNanoFileNames();
+    }
+    if (splitByFiles) {
+        loadJobFileNames();
+    }
 }
 
 SkimFile::~SkimFile() noexcept {
@@ -51,6 +64,7 @@ void SkimFile::loadInput() {
         }
         loadedNthJob_ = std::stoi(jobTokens.at(0));
         loadedTotJob_ = std::stoi(jobTokens.at(1));
+        nameTotJob_ = loadedTotJob_;
     } catch (const std::exception& e) {
         std::ostringstream oss;
         oss << "Error in loadInput(): " << e.what() << "\n"
@@ -121,6 +135,39 @@ void SkimFile::loadInputJson() {
     }
 }
 
+// Same file list and access as Skim/cpp/NanoTree.cpp: local EOS if present, else xrootd
+void SkimFile::loadNanoFileNames() {
+    std::cout << "==> loadNanoFileNames()" << '\n';
+    // FilesSkim_<Channel>_<Year>.json -> FilesNano_<Channel>_<Year>.json
+    const std::string skimJsonName = "FilesSkim_";
+    std::string nanoJsonPath = inputJsonPath_;
+    nanoJsonPath.replace(nanoJsonPath.rfind(skimJsonName), skimJsonName.size(), "FilesNano_");
+    std::ifstream inputFile(nanoJsonPath);
+    if (!inputFile.is_open()) {
+        throw std::runtime_error("Unable to open input JSON file: " + nanoJsonPath);
+    }
+    nlohmann::json js;
+    try {
+        inputFile >> js;
+        std::vector<std::string> nanoFiles;
+        js.at(loadedSampKey_).get_to(nanoFiles);
+        loadedAllFileNames_.clear();
+        for (const auto& fName : nanoFiles) {
+            const std::string eosPath = "/eos/cms/" + fName;
+            loadedAllFileNames_.push_back(std::filesystem::exists(eosPath) ? eosPath
+                                          : "root://cms-xrd-global.cern.ch/" + fName);
+        }
+    } catch (const std::exception& e) {
+        std::ostringstream oss;
+        oss << "Error reading NanoAOD files of " << loadedSampKey_ << " from " << nanoJsonPath << "\n"
+            << e.what();
+        throw std::runtime_error(oss.str());
+    }
+    isNanoInput_ = true;
+    loadedTotJob_ = nameTotJob_;
+    std::cout << "NanoAOD files = " << loadedAllFileNames_.size() << '\n';
+}
+
 void SkimFile::loadJobFileNames() {
     std::cout << "==> loadJobFileNames()" << '\n';
     const int nFiles = static_cast<int>(loadedAllFileNames_.size());
@@ -150,3 +197,135 @@ void SkimFile::loadJobFileNames() {
     loadedJobFileNames_ = smallVectors[loadedNthJob_ - 1];
 }
 
+
+// Same acceptance as SkimTree::validateAndOpenFile(): files skipped there count 0 here
+Long64_t SkimFile::countEntries(const std::string& fileName) {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    if (!file || file->IsZombie() || file->GetSize() < 3000) {
+        std::cerr << "Warning: cannot use " << fileName << ", counting 0 entries\n";
+        return 0;
+    }
+    TTree* tree = dynamic_cast<TTree*>(file->Get("Events"));
+    if (tree) return tree->GetEntries();
+    file.reset();
+    return SkimTree::isRNTupleFile(fileName) ? SkimTree::countNTupleEntries(fileName) : 0;
+}
+
+void SkimFile::loadFileEntries(const std::string& cacheFilePath) {
+    std::cout << "==> loadFileEntries()" << '\n';
+    // Skim and NanoAOD files of a sample are catalogued separately
+    const std::string cacheKey = isNanoInput_ ? loadedSampKey_ + "_Nano" : loadedSampKey_;
+    nlohmann::json cache;
+    std::ifstream inFile(cacheFilePath);
+    if (inFile) {
+        try {
+            inFile >> cache;
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: unreadable JSON cache " << cacheFilePath << ": " << e.what() << "\n";
+            cache = nlohmann::json();
+        }
+    }
+    if (!cache.is_object()) cache = nlohmann::json::object();
+
+    // The catalog is only valid for the exact same list of files; a
+    // malformed entry is a miss and gets rebuilt
+    bool hit = false;
+    try {
+        if (cache.contains(cacheKey) &&
+            cache[cacheKey].value("files", std::vector<std::string>{}) == loadedAllFileNames_) {
+            cache[cacheKey].at("entries").get_to(loadedFileEntries_);
+            hit = loadedFileEntries_.size() == loadedAllFileNames_.size();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Warning: bad cache entry for " << cacheKey << ": " << e.what() << "\n";
+    }
+
+    if (hit) {
+        std::cout << "Cache hit for sample: " << cacheKey << '\n';
+    } else {
+        std::cout << "Cache miss for sample: " << cacheKey << '\n';
+        loadedFileEntries_.clear();
+        loadedFileEntries_.reserve(loadedAllFileNames_.size());
+        for (const auto& fName : loadedAllFileNames_) {
+            loadedFileEntries_.push_back(countEntries(fName));
+            if (isDebug_) {
+                std::cout << fName << "  " << loadedFileEntries_.back() << '\n';
+            }
+        }
+        cache[cacheKey]["files"] = loadedAllFileNames_;
+        cache[cacheKey]["entries"] = loadedFileEntries_;
+
+        // Other jobs may read or write the catalog concurrently: write a
+        // private copy and rename it over the old one
+        const std::string tmpPath = cacheFilePath + ".tmp." + std::to_string(getpid());
+        std::ofstream outFile(tmpPath);
+        if (!outFile) {
+            std::cerr << "Warning: cannot write cache file " << tmpPath << "\n";
+        } else {
+            outFile << cache.dump(4);
+            outFile.close();
+            if (!outFile || std::rename(tmpPath.c_str(), cacheFilePath.c_str()) != 0) {
+                std::cerr << "Warning: cannot update cache file " << cacheFilePath << "\n";
+                std::remove(tmpPath.c_str());
+            }
+        }
+    }
+
+    if (loadedFileEntries_.size() != loadedAllFileNames_.size()) {
+        throw std::runtime_error("Error: entry catalog does not match the file list in " + cacheFilePath);
+    }
+    std::cout << "Total entries = " << getTotalEntries() << '\n';
+}
+
+Long64_t SkimFile::getTotalEntries() const {
+    return std::accumulate(loadedFileEntries_.begin(), loadedFileEntries_.end(), Long64_t{0});
+}
+
+void SkimFile::setEntryRange(Long64_t begin, Long64_t end) {
+    std::cout << "==> setEntryRange()" << '\n';
+    if (loadedFileEntries_.empty()) {
+        throw std::runtime_error("Error: call loadFileEntries() before setEntryRange()");
+    }
+    const Long64_t total = getTotalEntries();
+    if (end < 0 || end > total) end = total;
+    if (begin < 0 || begin > end) {
+        throw std::runtime_error("Error: invalid entry range " + std::to_string(begin) +
+                                 ":" + std::to_string(end) + " for " + std::to_string(total) + " entries");
+    }
+
+    // Keep every file overlapping [begin, end), plus the file holding 'end'
+    // so that SkimTree can align the upper edge to the same cluster as the
+    // lower edge of the next shard.
+    loadedJobFileNames_.clear();
+    jobEntryBegin_ = 0;
+    jobEntryEnd_ = 0;
+    Long64_t fileBegin = 0;
+    Long64_t chainOffset = -1;
+    for (size_t i = 0; i < loadedAllFileNames_.size(); ++i) {
+        const Long64_t fileEnd = fileBegin + loadedFileEntries_[i];
+        if (loadedFileEntries_[i] > 0 && fileEnd > begin && fileBegin <= end) {
+            if (fileBegin == end && !loadedJobFileNames_.empty()) {
+                break; // 'end' sits exactly on a file boundary
+            }
+            if (chainOffset < 0) chainOffset = fileBegin;
+            loadedJobFileNames_.push_back(loadedAllFileNames_[i]);
+        }
+        fileBegin = fileEnd;
+    }
+    if (loadedJobFileNames_.empty()) {
+        throw std::runtime_error("Error: no file overlaps the entry range in setEntryRange()");
+    }
+    jobEntryBegin_ = begin - chainOffset;
+    jobEntryEnd_ = end - chainOffset;
+
+    std::cout << "Global entries [" << begin << ", " << end << ") of " << total
+              << " in " << loadedJobFileNames_.size() << " file(s)" << '\n';
+}
+
+void SkimFile::setBalancedEntryRange() {
+    const Long64_t total = getTotalEntries();
+    // loadedTotJob_ may have been clamped to the number of files
+    const Long64_t begin = total * (loadedNthJob_ - 1) / nameTotJob_;
+    const Long64_t end = total * loadedNthJob_ / nameTotJob_;
+    setEntryRange(begin, end);
+}
@@ -3,8 +3,41 @@
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <TH1D.h>
+#include <TKey.h>
+#include <nlohmann/json.hpp>
 #include "SkimTree.h"
 
+#ifdef USE_RNTUPLE
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RNTupleReader.hxx>
+#include <ROOT/RNTupleView.hxx>
+
+namespace rnt = ROOT::Experimental;
+
+namespace {
+
+// Copy one RNTuple field into a SkimTree variable. Arrays are stored by the
+// Skim as std::vector<T>; at most 'length' elements fit the fixed array.
+template <typename Field, typename Value>
+auto makeNTupleRead(rnt::RNTupleReader& reader, const std::string& name,
+                    void* address, std::size_t length, bool isArray) -> std::function<void(Long64_t)> {
+    auto* out = static_cast<Value*>(address);
+    if (!isArray) {
+        auto view = std::make_shared<rnt::RNTupleView<Field>>(reader.GetView<Field>(name));
+        return [view, out](Long64_t i) { *out = static_cast<Value>((*view)(i)); };
+    }
+    auto view = std::make_shared<rnt::RNTupleView<std::vector<Field>>>(reader.GetView<std::vector<Field>>(name));
+    return [view, out, length](Long64_t i) {
+        const auto& values = (*view)(i);
+        const std::size_t n = std::min(values.size(), length);
+        std::copy(values.begin(), values.begin() + n, out);
+    };
+}
+
+} // namespace
+#endif
+
 SkimTree::SkimTree(GlobalFlag& globalFlags): 
     globalFlags_(globalFlags),
     trigDetail_(globalFlags),
@@ -76,11 +109,27 @@ void SkimTree::loadTree(std::vector<std::string> skimFileList) {
         throw std::runtime_error("Error: No files to load in loadTree()");
     }
 
+    isRNTuple_ = isRNTupleFile(skimFileList.front());
+    if (isRNTuple_ && isNanoInput_) {
+        throw std::runtime_error("Error: NanoAOD input is always TTree, got RNTuple in loadTree()");
+    }
+    if (isRNTuple_) {
+        std::cout << "Reading 'Events' as RNTuple" << '\n';
+    }
+
     std::string dir = ""; // Adjust as needed
     for (const auto& fName : skimFileList) {
         totalFiles++;
         std::string fullPath = fName;
         std::cout << fullPath << '\n';
+        if (isRNTuple_) {
+            if (addNTupleFile(fullPath)) {
+                addedFiles++;
+            } else {
+                failedFiles++;
+            }
+            continue;
+        }
         // Validate and open the file
         TFile* file = validateAndOpenFile(fullPath);
         if (!file) {
@@ -104,41 +153,49 @@ void SkimTree::loadTree(std::vector<std::string> skimFileList) {
     std::cout << "Successfully added files: " << addedFiles << '\n';
     std::cout << "Failed to add files: " << failedFiles << '\n';
 
-    if (fChain_->GetNtrees() == 0) {
+    if (isRNTuple_ ? ntupleFiles_.empty() : fChain_->GetNtrees() == 0) {
         std::cerr << "Error: No valid ROOT files were added to the TChain. Exiting.\n";
         return;
     }
 
 
-    fChain_->SetBranchStatus("*", true);
-    fChain_->SetBranchAddress("run", &run);
-    fChain_->SetBranchAddress("luminosityBlock", &luminosityBlock);
-    fChain_->SetBranchAddress("event", &event);
+    if (isNanoInput_) {
+        // Read only what a skim of these files would contain
+        fChain_->SetBranchStatus("*", false);
+        for (const auto& pattern : skimBranches_) {
+            fChain_->SetBranchStatus(pattern.c_str(), true);
+        }
+    } else {
+        fChain_->SetBranchStatus("*", true);
+    }
+    bindBranch("run", &run);
+    bindBranch("luminosityBlock", &luminosityBlock);
+    bindBranch("event", &event);
 
 	//--------------------------------------- 
 	//Jet for all channels 
 	//--------------------------------------- 
-	fChain_->SetBranchAddress("nJet", &nJet);
-	fChain_->SetBranchAddress("Jet_area", &Jet_area);
-
-	fChain_->SetBranchAddress("Jet_btagDeepFlavB", &Jet_btagDeepFlavB);
-	fChain_->SetBranchAddress("Jet_btagDeepFlavCvL", &Jet_btagDeepFlavCvL);
-	fChain_->SetBranchAddress("Jet_btagDeepFlavCvB", &Jet_btagDeepFlavCvB);
-	fChain_->SetBranchAddress("Jet_btagDeepFlavG", &Jet_btagDeepFlavG);
-	fChain_->SetBranchAddress("Jet_btagDeepFlavQG", &Jet_btagDeepFlavQG);
+	bindBranch("nJet", &nJet);
+	bindBranch("Jet_area", &Jet_area);
+
+	bindBranch("Jet_btagDeepFlavB", &Jet_btagDeepFlavB);
+	bindBranch("Jet_btagDeepFlavCvL", &Jet_btagDeepFlavCvL);
+	bindBranch("Jet_btagDeepFlavCvB", &Jet_btagDeepFlavCvB);
+	bindBranch("Jet_btagDeepFlavG", &Jet_btagDeepFlavG);
+	bindBranch("Jet_btagDeepFlavQG", &Jet_btagDeepFlavQG);
 	//fChain_->SetBranchAddress("Jet_btagDeepFlavUDS", &Jet_btagDeepFlavUDS);
 
-	fChain_->SetBranchAddress("Jet_chEmEF"  , &Jet_chEmEF);
-	fChain_->SetBranchAddress("Jet_chHEF"   , &Jet_chHEF);
-	fChain_->SetBranchAddress("Jet_eta"     , &Jet_eta);
-	fChain_->SetBranchAddress("Jet_mass"    , &Jet_mass);
-	fChain_->SetBranchAddress("Jet_muEF"    , &Jet_muEF);
-	fChain_->SetBranchAddress("Jet_neEmEF"  , &Jet_neEmEF);
-	fChain_->SetBranchAddress("Jet_neHEF"   , &Jet_neHEF);
-	fChain_->SetBranchAddress("Jet_phi"     , &Jet_phi);
-	fChain_->SetBranchAddress("Jet_pt"    , &Jet_pt);
-	fChain_->SetBranchAddress("Jet_rawFactor", &Jet_rawFactor);
-	fChain_->SetBranchAddress("Jet_jetId", &Jet_jetId);
+	bindBranch("Jet_chEmEF"  , &Jet_chEmEF);
+	bindBranch("Jet_chHEF"   , &Jet_chHEF);
+	bindBranch("Jet_eta"     , &Jet_eta);
+	bindBranch("Jet_mass"    , &Jet_mass);
+	bindBranch("Jet_muEF"    , &Jet_muEF);
+	bindBranch("Jet_neEmEF"  , &Jet_neEmEF);
+	bindBranch("Jet_neHEF"   , &Jet_neHEF);
+	bindBranch("Jet_phi"     , &Jet_phi);
+	bindBranch("Jet_pt"    , &Jet_pt);
+	bindBranch("Jet_rawFactor", &Jet_rawFactor);
+	bindBranch("Jet_jetId", &Jet_jetId);
 	
 	//--------------------------------------- 
 	// HLT 
@@ -149,18 +206,18 @@ void SkimTree::loadTree(std::vector<std::string> skimFileList) {
 	// Photon (for GamJet)
 	//--------------------------------------- 
 	if(channel_ == GlobalFlag::Channel::GamJet){
-	  	fChain_->SetBranchAddress("nPhoton", &nPhoton);
-	  	fChain_->SetBranchAddress("Photon_eCorr", &Photon_eCorr);
-	  	fChain_->SetBranchAddress("Photon_energyErr", &Photon_energyErr);
-	  	fChain_->SetBranchAddress("Photon_eta", &Photon_eta);
-	  	fChain_->SetBranchAddress("Photon_hoe", &Photon_hoe);
-	  	fChain_->SetBranchAddress("Photon_mass", &Photon_mass);
-	  	fChain_->SetBranchAddress("Photon_phi", &Photon_phi);
-	  	fChain_->SetBranchAddress("Photon_pt", &Photon_pt);
-	  	fChain_->SetBranchAddress("Photon_r9", &Photon_r9);
-	  	fChain_->SetBranchAddress("Photon_cutBased", &Photon_cutBased);
-	  	fChain_->SetBranchAddress("Photon_jetIdx", &Photon_jetIdx);
-	  	fChain_->SetBranchAddress("Photon_seedGain", &Photon_seedGain);
+	  	bindBranch("nPhoton", &nPhoton);
+	  	bindBranch("Photon_eCorr", &Photon_eCorr);
+	  	bindBranch("Photon_energyErr", &Photon_energyErr);
+	  	bindBranch("Photon_eta", &Photon_eta);
+	  	bindBranch("Photon_hoe", &Photon_hoe);
+	  	bindBranch("Photon_mass", &Photon_mass);
+	  	bindBranch("Photon_phi", &Photon_phi);
+	  	bindBranch("Photon_pt", &Photon_pt);
+	  	bindBranch("Photon_r9", &Photon_r9);
+	  	bindBranch("Photon_cutBased", &Photon_cutBased);
+	  	bindBranch("Photon_jetIdx", &Photon_jetIdx);
+	  	bindBranch("Photon_seedGain", &Photon_seedGain);
 	}//GamJet
 	
 	//--------------------------------------- 
@@ -171,17 +228,17 @@ void SkimTree::loadTree(std::vector<std::string> skimFileList) {
 		fChain_->SetBranchStatus("nElectron",true);
 		fChain_->SetBranchStatus("Electron_*",true);
 		//address
-		fChain_->SetBranchAddress("nElectron", &nElectron);
-		fChain_->SetBranchAddress("Electron_charge", &Electron_charge);	
-		fChain_->SetBranchAddress("Electron_pt", &Electron_pt);
-		fChain_->SetBranchAddress("Electron_deltaEtaSC", &Electron_deltaEtaSC);
-		fChain_->SetBranchAddress("Electron_eta", &Electron_eta);
-		fChain_->SetBranchAddress("Electron_phi", &Electron_phi);
-		fChain_->SetBranchAddress("Electron_mass", &Electron_mass);
-		fChain_->SetBranchAddress("Electron_eCorr", &Electron_eCorr);
-		fChain_->SetBranchAddress("Electron_cutBased", &Electron_cutBased);
-	    fChain_->SetBranchAddress("Jet_electronIdx1", &Jet_electronIdx1);
-	    fChain_->SetBranchAddress("Jet_electronIdx2", &Jet_electronIdx2);
+		bindBranch("nElectron", &nElectron);
+		bindBranch("Electron_charge", &Electron_charge);	
+		bindBranch("Electron_pt", &Electron_pt);
+		bindBranch("Electron_deltaEtaSC", &Electron_deltaEtaSC);
+		bindBranch("Electron_eta", &Electron_eta);
+		bindBranch("Electron_phi", &Electron_phi);
+		bindBranch("Electron_mass", &Electron_mass);
+		bindBranch("Electron_eCorr", &Electron_eCorr);
+		bindBranch("Electron_cutBased", &Electron_cutBased);
+	    bindBranch("Jet_electronIdx1", &Jet_electronIdx1);
+	    bindBranch("Jet_electronIdx2", &Jet_electronIdx2);
 	
 	}
 	
@@ -193,63 +250,184 @@ void SkimTree::loadTree(std::vector<std::string> skimFileList) {
 	  	fChain_->SetBranchStatus("nMuon",true);
 	  	fChain_->SetBranchStatus("Muon_*",true);
 	  	//address
-	  	fChain_->SetBranchAddress("nMuon", &nMuon);
-	  	fChain_->SetBranchAddress("Muon_nTrackerLayers", &Muon_nTrackerLayers);
-	  	fChain_->SetBranchAddress("Muon_charge", &Muon_charge);
-	  	fChain_->SetBranchAddress("Muon_pt", &Muon_pt);
-	  	fChain_->SetBranchAddress("Muon_eta", &Muon_eta);
-	  	fChain_->SetBranchAddress("Muon_phi", &Muon_phi);
-	  	fChain_->SetBranchAddress("Muon_mass", &Muon_mass);
-	  	fChain_->SetBranchAddress("Muon_mediumId", &Muon_mediumId);
-	  	fChain_->SetBranchAddress("Muon_tightId", &Muon_tightId);
-	  	fChain_->SetBranchAddress("Muon_highPurity", &Muon_highPurity);
-	  	fChain_->SetBranchAddress("Muon_pfRelIso04_all", &Muon_pfRelIso04_all);
-	  	fChain_->SetBranchAddress("Muon_tkRelIso", &Muon_tkRelIso);
-	  	fChain_->SetBranchAddress("Muon_dxy", &Muon_dxy);
-	  	fChain_->SetBranchAddress("Muon_dz", &Muon_dz);
-	    fChain_->SetBranchAddress("Jet_muonIdx1", &Jet_muonIdx1);
-	    fChain_->SetBranchAddress("Jet_muonIdx2", &Jet_muonIdx2);
+	  	bindBranch("nMuon", &nMuon);
+	  	bindBranch("Muon_nTrackerLayers", &Muon_nTrackerLayers);
+	  	bindBranch("Muon_charge", &Muon_charge);
+	  	bindBranch("Muon_pt", &Muon_pt);
+	  	bindBranch("Muon_eta", &Muon_eta);
+	  	bindBranch("Muon_phi", &Muon_phi);
+	  	bindBranch("Muon_mass", &Muon_mass);
+	  	bindBranch("Muon_mediumId", &Muon_mediumId);
+	  	bindBranch("Muon_tightId", &Muon_tightId);
+	  	bindBranch("Muon_highPurity", &Muon_highPurity);
+	  	bindBranch("Muon_pfRelIso04_all", &Muon_pfRelIso04_all);
+	  	bindBranch("Muon_tkRelIso", &Muon_tkRelIso);
+	  	bindBranch("Muon_dxy", &Muon_dxy);
+	  	bindBranch("Muon_dz", &Muon_dz);
+	    bindBranch("Jet_muonIdx1", &Jet_muonIdx1);
+	    bindBranch("Jet_muonIdx2", &Jet_muonIdx2);
 	}
 	
-	fChain_->SetBranchAddress("ChsMET_phi", &ChsMET_phi);
-	fChain_->SetBranchAddress("ChsMET_pt",  &ChsMET_pt);
-	fChain_->SetBranchAddress("fixedGridRhoFastjetAll", &Rho);
-	fChain_->SetBranchAddress("PV_z", &PV_z);
+	bindBranch("ChsMET_phi", &ChsMET_phi);
+	bindBranch("ChsMET_pt",  &ChsMET_pt);
+	bindBranch("fixedGridRhoFastjetAll", &Rho);
+	bindBranch("PV_z", &PV_z);
 	//fChain_->SetBranchAddress("GenVtx_z", &GenVtx_z);
-	fChain_->SetBranchAddress("PV_npvs", &PV_npvs);
-	fChain_->SetBranchAddress("PV_npvsGood", &PV_npvsGood);
+	bindBranch("PV_npvs", &PV_npvs);
+	bindBranch("PV_npvsGood", &PV_npvsGood);
 	
 	
 	if (isMC_){ 
-		fChain_->SetBranchAddress("genWeight", &genWeight);
-		fChain_->SetBranchAddress("nPSWeight", &nPSWeight);
+		bindBranch("genWeight", &genWeight);
+		bindBranch("nPSWeight", &nPSWeight);
 		//fChain_->SetBranchAddress("PSWeight", &PSWeight);//seg fault
-		fChain_->SetBranchAddress("Pileup_nTrueInt", &Pileup_nTrueInt);
+		bindBranch("Pileup_nTrueInt", &Pileup_nTrueInt);
 		
-		fChain_->SetBranchAddress("nGenJet", &nGenJet);
-		fChain_->SetBranchAddress("GenJet_eta", &GenJet_eta);
-		fChain_->SetBranchAddress("GenJet_mass", &GenJet_mass);
-		fChain_->SetBranchAddress("GenJet_phi", &GenJet_phi);
-		fChain_->SetBranchAddress("GenJet_pt", &GenJet_pt);
-		fChain_->SetBranchAddress("GenJet_partonFlavour", &GenJet_partonFlavour);
-		fChain_->SetBranchAddress("LHE_HT", &LHE_HT);
-		fChain_->SetBranchAddress("Jet_genJetIdx", &Jet_genJetIdx);
+		bindBranch("nGenJet", &nGenJet);
+		bindBranch("GenJet_eta", &GenJet_eta);
+		bindBranch("GenJet_mass", &GenJet_mass);
+		bindBranch("GenJet_phi", &GenJet_phi);
+		bindBranch("GenJet_pt", &GenJet_pt);
+		bindBranch("GenJet_partonFlavour", &GenJet_partonFlavour);
+		bindBranch("LHE_HT", &LHE_HT);
+		bindBranch("Jet_genJetIdx", &Jet_genJetIdx);
 	  	if (channel_ == GlobalFlag::Channel::GamJet){
-	   		fChain_->SetBranchAddress("nGenIsolatedPhoton", &nGenIsolatedPhoton);
-	   		fChain_->SetBranchAddress("GenIsolatedPhoton_eta", &GenIsolatedPhoton_eta);
-	   		fChain_->SetBranchAddress("GenIsolatedPhoton_mass", &GenIsolatedPhoton_mass);
-	   		fChain_->SetBranchAddress("GenIsolatedPhoton_phi", &GenIsolatedPhoton_phi);
-	   		fChain_->SetBranchAddress("GenIsolatedPhoton_pt", &GenIsolatedPhoton_pt);
+	   		bindBranch("nGenIsolatedPhoton", &nGenIsolatedPhoton);
+	   		bindBranch("GenIsolatedPhoton_eta", &GenIsolatedPhoton_eta);
+	   		bindBranch("GenIsolatedPhoton_mass", &GenIsolatedPhoton_mass);
+	   		bindBranch("GenIsolatedPhoton_phi", &GenIsolatedPhoton_phi);
+	   		bindBranch("GenIsolatedPhoton_pt", &GenIsolatedPhoton_pt);
 	  	}
 	  	if (channel_ == GlobalFlag::Channel::ZeeJet || channel_ == GlobalFlag::Channel::ZmmJet){
-	   		fChain_->SetBranchAddress("nGenDressedLepton", &nGenDressedLepton);
-	   		fChain_->SetBranchAddress("GenDressedLepton_eta", &GenDressedLepton_eta);
-	   		fChain_->SetBranchAddress("GenDressedLepton_mass", &GenDressedLepton_mass);
-	   		fChain_->SetBranchAddress("GenDressedLepton_phi", &GenDressedLepton_phi);
-	   		fChain_->SetBranchAddress("GenDressedLepton_pt", &GenDressedLepton_pt);
-	   		fChain_->SetBranchAddress("GenDressedLepton_pdgId", &GenDressedLepton_pdgId);
+	   		bindBranch("nGenDressedLepton", &nGenDressedLepton);
+	   		bindBranch("GenDressedLepton_eta", &GenDressedLepton_eta);
+	   		bindBranch("GenDressedLepton_mass", &GenDressedLepton_mass);
+	   		bindBranch("GenDressedLepton_phi", &GenDressedLepton_phi);
+	   		bindBranch("GenDressedLepton_pt", &GenDressedLepton_pt);
+	   		bindBranch("GenDressedLepton_pdgId", &GenDressedLepton_pdgId);
 	  	}
 	} // isMC_
+
+    if (isNanoInput_) {
+        bindSkimSelection();
+    }
+}
+
+
+//--------------------------------------- 
+// Skim selection for NanoAOD input
+//--------------------------------------- 
+void SkimTree::setSkimSelection(const std::string& commonConfigPath, const std::string& channelConfigPath) {
+    std::cout << "==> setSkimSelection()" << '\n';
+    auto readJson = [](const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open Skim config: " + path);
+        }
+        nlohmann::json js;
+        file >> js;
+        return js;
+    };
+    const nlohmann::json common = readJson(commonConfigPath);
+    const nlohmann::json channel = readJson(channelConfigPath);
+
+    // Skim uses one configuration for both 2016 periods
+    std::string runPeriod;
+    if (year_ == GlobalFlag::Year::Year2016Pre || year_ == GlobalFlag::Year::Year2016Post)
+        runPeriod = "2016";
+    else if (year_ == GlobalFlag::Year::Year2017)
+        runPeriod = "2017";
+    else if (year_ == GlobalFlag::Year::Year2018)
+        runPeriod = "2018";
+    else
+        throw std::runtime_error("Unknown run period in SkimTree::setSkimSelection()");
+
+    // Same lists as Skim/cpp/RunChannel.cpp
+    auto append = [](std::vector<std::string>& to, const nlohmann::json& js, const std::string& key) {
+        if (js.contains(key)) {
+            const auto list = js.at(key).get<std::vector<std::string>>();
+            to.insert(to.end(), list.begin(), list.end());
+        }
+    };
+    skimBranches_.clear();
+    append(skimBranches_, common, "commonTreeBranches");
+    append(skimBranches_, channel, "treeBranches");
+    if (isMC_) {
+        append(skimBranches_, common, "commonMCBranches");
+        append(skimBranches_, channel, "mcBranches");
+    }
+    skimFilterNames_ = common.at("filters").at(runPeriod).get<std::vector<std::string>>();
+    skimTrigNames_ = channel.at("triggers").at(runPeriod).get<std::vector<std::string>>();
+    skimBranches_.insert(skimBranches_.end(), skimFilterNames_.begin(), skimFilterNames_.end());
+    skimBranches_.insert(skimBranches_.end(), skimTrigNames_.begin(), skimTrigNames_.end());
+
+    isNanoInput_ = true;
+    skimCutflow_ = {};
+    std::cout << "Skim filters: " << skimFilterNames_.size()
+              << ", Skim triggers: " << skimTrigNames_.size() << '\n';
+}
+
+void SkimTree::bindSkimSelection() {
+    // Sized once: the chain keeps the addresses
+    skimFilterValues_.assign(skimFilterNames_.size(), 0);
+    skimFilterBranches_.assign(skimFilterNames_.size(), nullptr);
+    skimTrigStorage_.assign(skimTrigNames_.size(), 0);
+    skimTrigValues_.assign(skimTrigNames_.size(), nullptr);
+    skimTrigBranches_.assign(skimTrigNames_.size(), nullptr);
+
+    // Missing branches stay nullptr and are skipped, as in the Skim
+    auto* branches = fChain_->GetListOfBranches();
+    for (size_t i = 0; i < skimFilterNames_.size(); ++i) {
+        const char* name = skimFilterNames_[i].c_str();
+        if (!branches || !branches->FindObject(name)) continue;
+        fChain_->SetBranchStatus(name, true);
+        fChain_->SetBranchAddress(name, &skimFilterValues_[i], &skimFilterBranches_[i]);
+    }
+    for (size_t i = 0; i < skimTrigNames_.size(); ++i) {
+        const char* name = skimTrigNames_[i].c_str();
+        // Share the storage of triggers already bound for TrigDetail
+        auto it = trigNameToIndex_.find(skimTrigNames_[i]);
+        skimTrigValues_[i] = (it != trigNameToIndex_.end()) ? &trigValues_[it->second] : &skimTrigStorage_[i];
+        if (!branches || !branches->FindObject(name)) continue;
+        fChain_->SetBranchStatus(name, true);
+        fChain_->SetBranchAddress(name, skimTrigValues_[i], &skimTrigBranches_[i]);
+    }
+}
+
+auto SkimTree::passSkimSelection(Long64_t ientry) -> bool {
+    if (!isNanoInput_) return true;
+
+    ++skimCutflow_[0];
+    for (size_t i = 0; i < skimFilterBranches_.size(); ++i) {
+        if (!skimFilterBranches_[i]) continue;
+        skimFilterBranches_[i]->GetEntry(ientry);
+        if (!skimFilterValues_[i]) return false;
+    }
+    ++skimCutflow_[1];
+
+    for (size_t i = 0; i < skimTrigBranches_.size(); ++i) {
+        if (!skimTrigBranches_[i]) continue;
+        skimTrigBranches_[i]->GetEntry(ientry);
+        if (*skimTrigValues_[i]) {
+            ++skimCutflow_[2];
+            return true;
+        }
+    }
+    return false;
+}
+
+void SkimTree::writeSkimCutflow(TDirectory* dir) const {
+    if (!isNanoInput_ || !dir) return;
+    const std::array<std::string, 3> cuts = {"NanoAOD", "Filter", "Trigger"};
+    std::cout << "Skim cutflow (in memory):" << '\n';
+    dir->cd();
+    TH1D h1EventInSkimCutflow("h1EventInSkimCutflow", "", cuts.size(), 0.5, cuts.size() + 0.5);
+    for (size_t i = 0; i < cuts.size(); ++i) {
+        h1EventInSkimCutflow.GetXaxis()->SetBinLabel(i + 1, cuts[i].c_str());
+        h1EventInSkimCutflow.SetBinContent(i + 1, skimCutflow_[i]);
+        std::cout << "  " << cuts[i] << " = " << skimCutflow_[i] << '\n';
+    }
+    h1EventInSkimCutflow.Write();
 }
 
 
@@ -261,6 +439,10 @@ void SkimTree::initializeTriggers() {
 
     size_t numTriggers = triggerNames.size();
     std::cout<<"numTriggers = "<<numTriggers<<std::endl;
+    if (numTriggers > maxTrigs) {
+        throw std::runtime_error("SkimTree::initializeTriggers: " + std::to_string(numTriggers) +
+                                 " triggers, more than SkimTree::maxTrigs = " + std::to_string(maxTrigs));
+    }
     // Reserve space to prevent reallocations
     trigNames_.reserve(numTriggers);
     trigValues_.reserve(numTriggers);
@@ -274,7 +456,7 @@ void SkimTree::initializeTriggers() {
 
         // Set branch status and address
         fChain_->SetBranchStatus(trigName.c_str(), true);
-        fChain_->SetBranchAddress(trigName.c_str(), &trigValues_[index]);
+        bindBranch(trigName, &trigValues_[index]);
     }
     // After population
     if (isDebug_) {
@@ -300,16 +482,80 @@ Bool_t SkimTree::getTrigValue(const std::string& trigName) const {
     }
 }
 
-auto SkimTree::getEntries() const -> Long64_t {
+auto SkimTree::getTrigId(const std::string& trigName) const -> int {
+    auto it = trigNameToIndex_.find(trigName);
+    return it != trigNameToIndex_.end() ? static_cast<int>(it->second) : -1;
+}
+
+auto SkimTree::getTrigBits() const -> TrigBits {
+    TrigBits bits;
+    for (size_t index = 0; index < trigValues_.size(); ++index) {
+        if (trigValues_[index]) bits.set(index);
+    }
+    return bits;
+}
+
+auto SkimTree::getChainEntries() const -> Long64_t {
+    if (isRNTuple_) return ntupleEntryEdges_.back();
     return fChain_ ? fChain_->GetEntries() : 0;
 }
 
+auto SkimTree::getEntries() const -> Long64_t {
+    return entryCount_ < 0 ? getChainEntries() : entryCount_;
+}
+
+// Start of the cluster holding the chain entry. Shards sharing a boundary
+// entry align it identically, so aligned ranges stay disjoint and complete.
+auto SkimTree::alignToCluster(Long64_t entry) -> Long64_t {
+    // RNTuple pages are read per field, a shard edge inside a cluster costs little
+    if (isRNTuple_) return entry;
+    if (entry <= 0 || entry >= fChain_->GetEntries()) return entry;
+    const Long64_t local = fChain_->LoadTree(entry);
+    TTree* tree = fChain_->GetTree();
+    if (local < 0 || !tree) {
+        throw std::runtime_error("Error loading entry " + std::to_string(entry) + " in alignToCluster()");
+    }
+    auto clusterIter = tree->GetClusterIterator(local);
+    return fChain_->GetChainOffset() + clusterIter();
+}
+
+void SkimTree::setEntryRange(Long64_t begin, Long64_t end) {
+    std::cout << "==> setEntryRange()" << '\n';
+    if (!fChain_) {
+        throw std::runtime_error("Error: fChain_ is not initialized in setEntryRange()");
+    }
+    const Long64_t nChain = getChainEntries();
+    if (end < 0 || end > nChain) end = nChain;
+    if (begin < 0 || begin > end) {
+        throw std::runtime_error("Error: invalid entry range in setEntryRange()");
+    }
+    const Long64_t alignedBegin = alignToCluster(begin);
+    const Long64_t alignedEnd = alignToCluster(end);
+    entryOffset_ = alignedBegin;
+    entryCount_ = alignedEnd - alignedBegin;
+    fCurrent_ = -1;
+    std::cout << "Requested [" << begin << ", " << end << "), cluster aligned ["
+              << alignedBegin << ", " << alignedEnd << ")" << '\n';
+}
+
 auto SkimTree::getChain() const -> TChain* {
     return fChain_.get();  // Return raw pointer to fChain_
 }
 
 auto SkimTree::getEntry(Long64_t entry) -> Int_t {
-    return fChain_ ? fChain_->GetEntry(entry) : 0;
+    if (isRNTuple_) {
+        readEntry(loadEntry(entry));
+        return 1;
+    }
+    return fChain_ ? fChain_->GetEntry(entryOffset_ + entry) : 0;
+}
+
+void SkimTree::readEntry(Long64_t localEntry) {
+    if (isRNTuple_) {
+        for (const auto& read : ntupleReads_) read(localEntry);
+        return;
+    }
+    fChain_->GetTree()->GetEntry(localEntry);
 }
 
 auto SkimTree::loadEntry(Long64_t entry) -> Long64_t {
@@ -317,7 +563,19 @@ auto SkimTree::loadEntry(Long64_t entry) -> Long64_t {
     if (!fChain_) {
         throw std::runtime_error("Error: fChain_ is not initialized in loadEntry()");
     }
-    Long64_t centry = fChain_->LoadTree(entry);
+    if (isRNTuple_) {
+        const Long64_t global = entryOffset_ + entry;
+        if (global < 0 || global >= ntupleEntryEdges_.back()) {
+            throw std::runtime_error("Error loading entry in loadEntry()");
+        }
+        if (ntupleCurrent_ < 0 || global < ntupleEntryEdges_[ntupleCurrent_] ||
+            global >= ntupleEntryEdges_[ntupleCurrent_ + 1]) {
+            auto edge = std::upper_bound(ntupleEntryEdges_.begin(), ntupleEntryEdges_.end(), global);
+            openNTupleFile(static_cast<int>(edge - ntupleEntryEdges_.begin()) - 1);
+        }
+        return global - ntupleEntryEdges_[ntupleCurrent_];
+    }
+    Long64_t centry = fChain_->LoadTree(entryOffset_ + entry);
     if (centry < 0) {
         throw std::runtime_error("Error loading entry in loadEntry()");
     }
@@ -329,3 +587,98 @@ auto SkimTree::loadEntry(Long64_t entry) -> Long64_t {
     return centry;
 }
 
+
+
+//--------------------------------------- 
+// RNTuple skim input
+//--------------------------------------- 
+auto SkimTree::isRNTupleFile(const std::string& fileName) -> bool {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    if (!file || file->IsZombie()) return false;
+    TKey* key = file->GetKey("Events");
+    return key && std::string(key->GetClassName()).find("RNTuple") != std::string::npos;
+}
+
+#ifdef USE_RNTUPLE
+auto SkimTree::countNTupleEntries(const std::string& fileName) -> Long64_t {
+    auto reader = rnt::RNTupleReader::Open("Events", fileName);
+    return static_cast<Long64_t>(reader->GetNEntries());
+}
+
+auto SkimTree::addNTupleFile(const std::string& fullPath) -> bool {
+    Long64_t nEntries = 0;
+    try {
+        nEntries = countNTupleEntries(fullPath);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Failed to open RNTuple 'Events' in " << fullPath << ": " << e.what() << '\n';
+        return false;
+    }
+    if (nEntries == 0) {
+        std::cerr << "Warning: 'Events' RNTuple in file " << fullPath << " has 0 entries. Skipping file.\n";
+        return false;
+    }
+    ntupleFiles_.push_back(fullPath);
+    ntupleEntryEdges_.push_back(ntupleEntryEdges_.back() + nEntries);
+    std::cout << "Total Entries: " << ntupleEntryEdges_.back() << '\n';
+    return true;
+}
+
+void SkimTree::openNTupleFile(int index) {
+    // Views refer to the reader: drop them before the reader goes away
+    ntupleReads_.clear();
+    ntupleReader_.reset();
+    auto reader = std::shared_ptr<rnt::RNTupleReader>(
+        rnt::RNTupleReader::Open("Events", ntupleFiles_.at(index)).release());
+    for (const auto& b : ntupleBindings_) {
+        try {
+            switch (b.type) {
+                case ColumnType::Bool:
+                    ntupleReads_.push_back(makeNTupleRead<bool, Bool_t>(*reader, b.name, b.address, b.length, b.isArray));
+                    break;
+                case ColumnType::Char: // Bool_t flags held as char
+                    ntupleReads_.push_back(makeNTupleRead<bool, char>(*reader, b.name, b.address, b.length, b.isArray));
+                    break;
+                case ColumnType::UChar:
+                    ntupleReads_.push_back(makeNTupleRead<UChar_t, UChar_t>(*reader, b.name, b.address, b.length, b.isArray));
+                    break;
+                case ColumnType::Short:
+                    ntupleReads_.push_back(makeNTupleRead<Short_t, Short_t>(*reader, b.name, b.address, b.length, b.isArray));
+                    break;
+                case ColumnType::Int:
+                    ntupleReads_.push_back(makeNTupleRead<Int_t, Int_t>(*reader, b.name, b.address, b.length, b.isArray));
+                    break;
+                case ColumnType::UInt:
+                    ntupleReads_.push_back(makeNTupleRead<UInt_t, UInt_t>(*reader, b.name, b.address, b.length, b.isArray));
+                    break;
+                case ColumnType::ULong64:
+                    ntupleReads_.push_back(makeNTupleRead<ULong64_t, ULong64_t>(*reader, b.name, b.address, b.length, b.isArray));
+                    break;
+                case ColumnType::Float:
+                    ntupleReads_.push_back(makeNTupleRead<Float_t, Float_t>(*reader, b.name, b.address, b.length, b.isArray));
+                    break;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: field " << b.name << " not readable in "
+                      << ntupleFiles_[index] << ": " << e.what() << '\n';
+        }
+    }
+    ntupleReader_ = reader;
+    ntupleCurrent_ = index;
+    if (isDebug_) {
+        std::cout << "Opened RNTuple file " << index << " with " << ntupleReads_.size() << " fields\n";
+    }
+}
+#else
+auto SkimTree::countNTupleEntries(const std::string& fileName) -> Long64_t {
+    throw std::runtime_error("Error: " + fileName + " holds an RNTuple, rebuild with 'make RNTUPLE=1'");
+}
+
+auto SkimTree::addNTupleFile(const std::string& fullPath) -> bool {
+    countNTupleEntries(fullPath);
+    return false;
+}
+
+void SkimTree::openNTupleFile(int /*index*/) {
+    throw std::runtime_error("Error: RNTuple input needs 'make RNTUPLE=1'");
+}
+#endif
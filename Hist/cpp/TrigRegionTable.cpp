@@ -0,0 +1,79 @@
+#include "TrigRegionTable.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+auto sortedEdges(std::vector<double> edges) -> std::vector<double> {
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    return edges;
+}
+
+// Bin i with edges[i] <= x < edges[i + 1], -1 outside (or NaN)
+inline auto findBin(const std::vector<double>& edges, double x) -> int {
+    const auto it = std::upper_bound(edges.begin(), edges.end(), x);
+    if (it == edges.begin() || it == edges.end()) return -1;
+    return static_cast<int>(it - edges.begin()) - 1;
+}
+
+auto indexOf(const std::vector<double>& edges, double x) -> int {
+    return static_cast<int>(std::lower_bound(edges.begin(), edges.end(), x) - edges.begin());
+}
+
+} // namespace
+
+TrigRegionTable::TrigRegionTable(const std::vector<Region>& regions) {
+    if (regions.empty()) return;
+
+    std::vector<double> ptEdges, etaEdges;
+    for (const auto& r : regions) {
+        if (!(r.ptMin < r.ptMax) || !(r.absEtaMin < r.absEtaMax)) {
+            throw std::runtime_error("TrigRegionTable: empty range for " + r.name);
+        }
+        ptEdges.insert(ptEdges.end(), {r.ptMin, r.ptMax});
+        etaEdges.insert(etaEdges.end(), {r.absEtaMin, r.absEtaMax});
+    }
+    ptEdges_ = sortedEdges(std::move(ptEdges));
+    etaEdges_ = sortedEdges(std::move(etaEdges));
+
+    const int nPt = static_cast<int>(ptEdges_.size()) - 1;
+    const int nEta = nEtaBins();
+    cellSlot_.assign(static_cast<size_t>(nPt) * nEta, -1);
+
+    for (size_t slot = 0; slot < regions.size(); ++slot) {
+        const auto& r = regions[slot];
+        for (int iPt = indexOf(ptEdges_, r.ptMin); iPt < indexOf(ptEdges_, r.ptMax); ++iPt) {
+            for (int iEta = indexOf(etaEdges_, r.absEtaMin); iEta < indexOf(etaEdges_, r.absEtaMax); ++iEta) {
+                int& owner = cellSlot_[iPt * nEta + iEta];
+                if (owner >= 0) {
+                    std::cout << "EXCEPTION: TrigRegionTable: " << r.name << " and " << regions[owner].name
+                              << " overlap at pt [" << ptEdges_[iPt] << ", " << ptEdges_[iPt + 1]
+                              << "), |eta| [" << etaEdges_[iEta] << ", " << etaEdges_[iEta + 1] << ")\n";
+                    throw std::runtime_error("TrigRegionTable: overlapping trigger ranges");
+                }
+                owner = static_cast<int>(slot);
+            }
+        }
+    }
+
+    for (int iPt = 0; iPt < nPt; ++iPt) {
+        for (int iEta = 0; iEta < nEta; ++iEta) {
+            if (cellSlot_[iPt * nEta + iEta] >= 0) continue;
+            std::cout << "Warning: TrigRegionTable: no trigger for pt [" << ptEdges_[iPt] << ", "
+                      << ptEdges_[iPt + 1] << "), |eta| [" << etaEdges_[iEta] << ", "
+                      << etaEdges_[iEta + 1] << ")\n";
+        }
+    }
+}
+
+auto TrigRegionTable::find(double pt, double absEta) const -> int {
+    if (cellSlot_.empty()) return -1;
+    const int iPt = findBin(ptEdges_, pt);
+    const int iEta = findBin(etaEdges_, absEta);
+    if (iPt < 0 || iEta < 0) return -1;
+    return cellSlot_[iPt * nEtaBins() + iEta];
+}
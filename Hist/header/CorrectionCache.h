@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Read-only view of an array inside the cache (or inside a std::vector)
+template <typename T>
+struct CacheArray {
+    const T* data{nullptr};
+    std::size_t size{0};
+
+    CacheArray() = default;
+    CacheArray(const T* d, std::size_t n) : data(d), size(n) {}
+    explicit CacheArray(const std::vector<T>& v) : data(v.data()), size(v.size()) {}
+
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    const T& operator[](std::size_t i) const { return data[i]; }
+    const T& front() const { return data[0]; }
+    const T& back() const { return data[size - 1]; }
+    bool empty() const { return size == 0; }
+};
+
+// Binary snapshot of the corrections of one year/era ("runMain -C").
+//
+// Layout: a 64 byte header (magic, format version, number of sections,
+// FNV-1a 64 checksum of everything after the header), a table of named
+// sections, then the payload with every section 64 byte aligned. The
+// file is mapped read-only with MAP_SHARED, so all jobs on a node share
+// one copy in the page cache and nothing is parsed at startup.
+//
+// Section names used by ScaleObject/ScaleEvent:
+//   corr/<name>        JSON text of one JERC correction (parsed with from_string)
+//   corr/<json>/<name> same for the jet veto map and pileup, keyed by their file
+//   grid/<name>/...    JercGrid tables
+//   veto/<json>/..., pu/<json>/..., roch/<json>/...
+//                      jet veto bitmap, pileup weights, Rochester table
+//   lumi/golden/<json>, lumi/hltPaths/<json>, lumi/hltRecords/<json>
+//                      golden JSON and HLT lumi as flat arrays
+// Sections built from a configurable file carry its path, so a job
+// configured with another file does not pick up the cached one.
+//   meta/sources       source files with size and mtime, see isUpToDate()
+class CorrectionCache {
+public:
+    static constexpr std::uint32_t kVersion = 1;
+
+    // Throws if the file is missing, truncated, of another version or
+    // fails the checksum
+    static std::shared_ptr<const CorrectionCache> open(const std::string& path);
+
+    // Default file of a year and era (MC: "MC")
+    static std::string defaultPath(const std::string& yearStr, const std::string& eraStr);
+
+    ~CorrectionCache();
+    CorrectionCache(const CorrectionCache&) = delete;
+    CorrectionCache& operator=(const CorrectionCache&) = delete;
+
+    bool has(const std::string& name) const { return sections_.count(name) > 0; }
+
+    template <typename T>
+    CacheArray<T> get(const std::string& name) const {
+        static_assert(std::is_trivially_copyable_v<T>, "CorrectionCache holds plain data only");
+        const auto& [ptr, size] = section(name);
+        if (size % sizeof(T) != 0) {
+            throw std::runtime_error("CorrectionCache: size of " + name + " does not match its type");
+        }
+        return CacheArray<T>(reinterpret_cast<const T*>(ptr), size / sizeof(T));
+    }
+
+    // NUL terminated text section
+    const char* getText(const std::string& name) const { return get<char>(name).data; }
+
+    // False (and prints why) if a source file changed after the cache was written
+    bool isUpToDate() const;
+
+    const std::string& getPath() const { return path_; }
+    std::size_t getSizeInBytes() const { return mapSize_; }
+
+    static std::uint64_t checksum(const unsigned char* data, std::size_t size);
+
+private:
+    CorrectionCache() = default;
+    std::string path_;
+    void* map_{nullptr};
+    std::size_t mapSize_{0};
+    std::map<std::string, std::pair<const unsigned char*, std::size_t>> sections_;
+
+    const std::pair<const unsigned char*, std::size_t>& section(const std::string& name) const;
+};
+
+// Collects sections and writes them in the CorrectionCache format
+class CorrectionCacheWriter {
+public:
+    template <typename T>
+    void add(const std::string& name, const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>, "CorrectionCache holds plain data only");
+        const auto* bytes = reinterpret_cast<const char*>(values.data());
+        addBytes(name, std::string(bytes, bytes + values.size() * sizeof(T)));
+    }
+    void addText(const std::string& name, const std::string& text) { addBytes(name, text + '\0'); }
+
+    // Input file the sections were made from, checked by isUpToDate()
+    void addSource(const std::string& path);
+
+    // Written to path.tmp and renamed, so readers never see a partial file
+    void write(const std::string& path) const;
+
+private:
+    std::map<std::string, std::string> sections_;
+    std::vector<std::string> sources_;
+    void addBytes(const std::string& name, std::string bytes);
+};
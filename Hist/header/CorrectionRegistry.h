@@ -0,0 +1,62 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "correction.h"
+#include "CorrectionCache.h"
+
+// Process-wide cache of parsed correctionlib JSONs, keyed by path.
+// jet_jerc.json.gz holds L1, L2Relative, L2L3Residual, JER resolution and
+// JER SF; with the registry it is decompressed and parsed once, and every
+// load*Ref() takes its Correction::Ref from the same CorrectionSet.
+class CorrectionRegistry {
+public:
+    static CorrectionRegistry& getInstance();
+
+    // Parse on first request, afterwards return the cached set
+    std::shared_ptr<const correction::CorrectionSet> get(const std::string& jsonPath);
+
+    // Shortcut for get(jsonPath)->at(name)
+    correction::Correction::Ref getCorrection(const std::string& jsonPath, const std::string& name);
+
+    // One correction from the corr/<name> text of a mapped cache, parsed once
+    correction::Correction::Ref getCorrection(const CorrectionCache& cache, const std::string& name);
+
+    // Same, from the text of the given cache section
+    correction::Correction::Ref getCorrection(const CorrectionCache& cache, const std::string& section,
+                                              const std::string& name);
+
+    // The raw JSON of one correction (binning edges etc.), for JercGrid.
+    // The file (.json or .json.gz) is read once; corrections are kept by name
+    // until releaseRawJson().
+    const nlohmann::json& getCorrectionJson(const std::string& jsonPath, const std::string& name);
+
+    // A CorrectionSet JSON holding only this correction, for the corr/<name> cache sections
+    std::string getStandaloneJson(const std::string& jsonPath, const std::string& name);
+
+    // Drop the raw JSON trees once the grids and bitmaps are built; a later
+    // getCorrectionJson() reads the file again
+    void releaseRawJson();
+
+    // Parse count, requests and parse time per file
+    void printStats() const;
+
+    int getNParsed() const { return static_cast<int>(sets_.size()); }
+    int getNRequests() const;
+
+private:
+    CorrectionRegistry() = default;
+    CorrectionRegistry(const CorrectionRegistry&) = delete;
+    CorrectionRegistry& operator=(const CorrectionRegistry&) = delete;
+
+    struct Entry {
+        std::shared_ptr<const correction::CorrectionSet> set;
+        int nRequests{0};
+        double parseSeconds{0.0};
+    };
+    std::map<std::string, Entry> sets_;
+    std::map<std::string, std::map<std::string, nlohmann::json>> rawCorrections_;
+    std::map<std::string, int> rawSchemaVersions_;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+// Stateless counter-based random numbers (Philox4x32-10, Salmon et al.,
+// SC11 "Parallel random numbers: as easy as 1, 2, 3").
+//
+// A draw is a pure function of (run, lumi, event, object index, purpose):
+// no seeding, no shared state, the same value for any thread count, job
+// split or event order, and cheap enough to call per jet. Use a distinct
+// Purpose for every independent use so the streams never overlap.
+namespace CounterRng {
+
+enum class Purpose : std::uint32_t {
+    JerSmear = 1,
+    MuRochSmear = 2,
+};
+
+using Block = std::array<std::uint32_t, 4>;
+
+inline Block philox4x32(Block ctr, std::array<std::uint32_t, 2> key) {
+    constexpr std::uint64_t kM0 = 0xD2511F53u;
+    constexpr std::uint64_t kM1 = 0xCD9E8D57u;
+    constexpr std::uint32_t kW0 = 0x9E3779B9u;
+    constexpr std::uint32_t kW1 = 0xBB67AE85u;
+    for (int round = 0; round < 10; ++round) {
+        const std::uint64_t p0 = kM0 * ctr[0];
+        const std::uint64_t p1 = kM1 * ctr[2];
+        ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<std::uint32_t>(p1),
+               static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<std::uint32_t>(p0)};
+        key[0] += kW0;
+        key[1] += kW1;
+    }
+    return ctr;
+}
+
+inline Block draw(std::uint32_t run, std::uint32_t lumi, std::uint64_t event, std::uint32_t index, Purpose purpose) {
+    return philox4x32({static_cast<std::uint32_t>(event), static_cast<std::uint32_t>(event >> 32), index,
+                       static_cast<std::uint32_t>(purpose)},
+                      {run, lumi});
+}
+
+// 53 bit uniform in the open interval (0, 1)
+inline double toUniform(std::uint32_t hi, std::uint32_t lo) {
+    const std::uint64_t bits = ((static_cast<std::uint64_t>(hi) << 32) | lo) >> 11;
+    return (static_cast<double>(bits) + 0.5) * 0x1.0p-53;
+}
+
+inline double uniform(std::uint32_t run, std::uint32_t lumi, std::uint64_t event, std::uint32_t index, Purpose purpose) {
+    const Block b = draw(run, lumi, event, index, purpose);
+    return toUniform(b[0], b[1]);
+}
+
+// Gaussian with mean 0 and width sigma (Box-Muller on one block)
+inline double gaus(double sigma, std::uint32_t run, std::uint32_t lumi, std::uint64_t event, std::uint32_t index,
+                   Purpose purpose) {
+    const Block b = draw(run, lumi, event, index, purpose);
+    const double u1 = toUniform(b[0], b[1]);
+    const double u2 = toUniform(b[2], b[3]);
+    return sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2);
+}
+
+} // namespace CounterRng
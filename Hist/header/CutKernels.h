@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Pass-mask kernels of ObjectCuts: one sweep over all candidates of an
+// object type per cut (mask[i] &= pass(col[i])), then one compaction of
+// the mask to an index list.
+//
+// A cut is a closed-interval test on the value as double (or its absolute
+// value), so every ObjectCuts::Op maps to two comparisons without
+// branches; strict bounds are moved to the neighbouring double, which is
+// exact for float, int and double input. The float/int/double sweeps and
+// count() are compiled for SSE4.2, AVX2 and AVX-512 (F+BW+VL) and the
+// widest set the CPU supports is picked at run time (scalar fallback).
+namespace CutKernels {
+
+enum class Isa { Scalar, Sse4, Avx2, Avx512 };
+
+enum class Mode : std::uint8_t {
+    Inside,     // lo <= v <= hi
+    NotInside,  // !(lo <= v <= hi)
+    Outside,    // v <= lo || v >= hi (false for NaN)
+};
+
+struct Test {
+    Mode mode;
+    bool abs;   // v = |x|
+    double lo;
+    double hi;
+};
+
+// mask[i] &= test(col[i]) for i < n
+void sweep(const float* col, std::size_t n, const Test& test, std::uint8_t* mask);
+void sweep(const int* col, std::size_t n, const Test& test, std::uint8_t* mask);
+void sweep(const double* col, std::size_t n, const Test& test, std::uint8_t* mask);
+
+// Same for the other column types (Bool_t, UChar_t, Short_t), scalar
+template <typename T>
+void sweepScalar(const T* col, std::size_t n, const Test& test, std::uint8_t* mask) {
+    for (std::size_t i = 0; i < n; ++i) {
+        double v = static_cast<double>(col[i]);
+        if (test.abs && v < 0) v = -v;
+        const bool inside = v >= test.lo && v <= test.hi;
+        const bool pass = test.mode == Mode::Inside ? inside
+                        : test.mode == Mode::NotInside ? !inside
+                        : (v <= test.lo || v >= test.hi);
+        mask[i] &= static_cast<std::uint8_t>(pass);
+    }
+}
+
+// Number of set entries of mask
+std::size_t count(const std::uint8_t* mask, std::size_t n);
+// Indices i with mask[i] set, increasing; returns their number
+std::size_t compact(const std::uint8_t* mask, std::size_t n, int* idx);
+
+// Kernels in use: the best supported by the CPU unless overridden
+// (setIsa is for benchmarks and checks; an unsupported Isa throws)
+Isa getIsa();
+void setIsa(Isa isa);
+bool isSupported(Isa isa);
+const char* isaName(Isa isa);
+
+} // namespace CutKernels
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "correction.h"
+
+// Electron and photon scale/smearing for all candidates of an event at once.
+//
+// The inputs are the plain NanoAOD arrays. Every kernel gives bitwise the
+// same numbers as the per-candidate functions below (and the matching
+// ScaleObject getters); benchmark/benchEgmSs.cpp checks and times both.
+namespace EgmSsKernel {
+
+// Electron_eCorr applied to the energy, as the pt ratio (ScaleObject::getEleSsCorrection)
+double eleSsCorrection(double pt, double eta, double mass, double eCorr);
+
+// cosh(eta) is computed once per electron in a first pass; the second pass
+// is plain arithmetic over arrays and vectorizes
+void eleSsCorrections(std::size_t n, const float* pt, const float* eta, const float* mass, const float* eCorr,
+                      double* corr);
+
+// Photon scale (nomOrSyst, seedGain, run, eta, r9, pt) and smearing
+// (nomOrSyst, eta, r9): the argument vector is built once per block with the
+// per-event inputs set, and only the per-photon slots change
+void phoScaleCorrections(const correction::Correction& ref, const std::string& nomOrSyst, unsigned int run,
+                         std::size_t n, const unsigned char* seedGain, const float* eta, const float* r9,
+                         const float* pt, double* corr);
+void phoSmearCorrections(const correction::Correction& ref, const std::string& nomOrSyst, std::size_t n,
+                         const float* eta, const float* r9, double* corr);
+
+} // namespace EgmSsKernel
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Runs a list of jobs in forked workers, at most nWorkers at a time.
+// Everything loaded before run() (correction sets, lumi JSONs, trigger
+// tables) is shared with the workers copy-on-write. A worker slot that
+// frees up takes the next pending job, so a few long jobs do not keep
+// the other slots idle.
+class ForkServer {
+public:
+    // nWorkers <= 0 means one worker per CPU core
+    explicit ForkServer(int nWorkers, const std::string& logDir);
+    ~ForkServer() = default;
+
+    ForkServer(const ForkServer&) = delete;
+    ForkServer& operator=(const ForkServer&) = delete;
+
+    // One job specification per non-empty line, '#' starts a comment
+    static std::vector<std::string> readJobList(const std::string& fileName);
+
+    // Runs work(job) in a child process per job. Returns the number of
+    // jobs that failed (non-zero exit code, exception or signal).
+    int run(const std::vector<std::string>& jobs,
+            const std::function<int(const std::string&)>& work);
+
+    [[nodiscard]] int getNWorkers() const { return nWorkers_; }
+
+private:
+    int nWorkers_;
+    std::string logDir_;
+
+    [[nodiscard]] std::string getLogPath(const std::string& job) const;
+};
@@ -77,6 +77,7 @@ public:
     // New helper functions to return string representations
     std::string getChannelStr() const;
     std::string getYearStr() const;
+    std::string getEraStr() const;  // e.g. "Era2018A", "" for MC
     std::string getDataStr() const;
     std::string getMcStr() const;
     double getLumiPerYear() const;
@@ -1,6 +1,7 @@
 #ifndef HISTSCALE_H
 #define HISTSCALE_H
 
+#include <array>
 #include <memory>
 #include <string>
 #include <iostream>
@@ -56,19 +57,17 @@ private:
     // Map to hold histograms for Photon
     std::unordered_map<std::string, std::unique_ptr<TH1D>> histPhoton1Pt_;
 
-    // Map to hold histograms for Jet
-    std::unordered_map<std::string, std::unique_ptr<TH1D>> histJet1Pt_;
-    std::unordered_map<std::string, std::unique_ptr<TH1D>> histJetSumPt_;
+    // Histograms for Jet, indexed by ScaleJetMet::Level
+    std::array<std::unique_ptr<TH1D>, ScaleJetMet::nLevels> histJet1Pt_;
+    std::array<std::unique_ptr<TH1D>, ScaleJetMet::nLevels> histJetSumPt_;
 
-    // Map to hold histograms for Met
-    std::unordered_map<std::string, std::unique_ptr<TH1D>> histMetPt_;
-    std::unordered_map<std::string, std::unique_ptr<TH1D>> histMetPhi_;
-    
-    // Map to hold histograms for JetMet
-    std::unordered_map<std::string, std::unique_ptr<TH1D>> histJetMetSumPt_;
+    // Histograms for Met and JetMet, for metLevels_ only
+    std::array<std::unique_ptr<TH1D>, ScaleJetMet::nLevels> histMetPt_;
+    std::array<std::unique_ptr<TH1D>, ScaleJetMet::nLevels> histMetPhi_;
+    std::array<std::unique_ptr<TH1D>, ScaleJetMet::nLevels> histJetMetSumPt_;
+    static constexpr std::array<ScaleJetMet::Level, 2> metLevels_{ScaleJetMet::Nano, ScaleJetMet::Corr};
 
     // Correction names
-    std::vector<std::string> jecNames_;
     std::vector<std::string> corrNames_;
     
     void InitializeHistograms(TDirectory* origDir, const std::string& directoryName, const VarBin& varBin);
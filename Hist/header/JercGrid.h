@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "correction.h"
+#include "CorrectionCache.h"
+
+// Dense lookup table for one JERC correction (L2Relative, L2L3Residual,
+// JER resolution, JER SF).
+//
+// These corrections are piecewise in JetEta (and Rho for the resolution)
+// and smooth in JetPt. The bin edges are read from the correction JSON, so
+// the table is exact in eta/rho. Within each cell the correctionlib value
+// is tabulated on a log(pt) grid and interpolated linearly. A string input
+// (the JER SF systematic) is fixed when the grid is built.
+//
+// Points outside the tabulated eta/rho/pt range go to correctionlib, so
+// flow and error behaviour stay exactly as before.
+class JercGrid {
+public:
+    struct Options {
+        int nPtPoints{1024};
+        double ptMin{1.0};
+        double ptMax{7000.0};
+    };
+
+    JercGrid(const correction::Correction::Ref& ref, const nlohmann::json& correctionJson,
+             const Options& options, const std::string& category = "");
+    JercGrid(const JercGrid&) = delete;
+    JercGrid& operator=(const JercGrid&) = delete;
+
+    // Tables as sections <prefix>/meta, /eta, /rho, /values, /category
+    void writeTo(CorrectionCacheWriter& writer, const std::string& prefix) const;
+    // Views into the mapped cache, nothing is copied
+    static std::unique_ptr<JercGrid> fromCache(const std::shared_ptr<const CorrectionCache>& cache,
+                                               const std::string& prefix, const correction::Correction::Ref& ref);
+    // Whether <prefix> is in the cache and was built with these options and category
+    static bool isCached(const CorrectionCache& cache, const std::string& prefix, const Options& options,
+                         const std::string& category);
+
+    // Missing inputs of the correction are ignored (e.g. pt for the JER SF)
+    double evaluate(double eta, double pt, double rho = 0.0) const;
+
+    // Same for n jets at once; rho may be nullptr if the correction has no Rho
+    void evaluate(std::size_t n, const float* eta, const float* pt, const float* rho, double* out) const;
+
+    const std::string& getCategory() const { return category_; }
+    std::size_t getSizeInBytes() const { return values_.size * sizeof(double); }
+
+    // Compare with correctionlib on nPoints random points inside the grid and
+    // print the maximum absolute and relative deviation. Returns the relative one.
+    double validate(int nPoints, unsigned int seed = 12345) const;
+
+private:
+    JercGrid() = default;
+    correction::Correction::Ref ref_;
+    std::string name_;
+    std::string category_;
+
+    enum class Input { Eta, Rho, Pt, Category };
+    std::vector<Input> inputs_; // in the order of the correction
+
+    CacheArray<double> etaEdges_;
+    CacheArray<double> rhoEdges_; // (-inf, inf) if there is no Rho input
+    bool hasPt_{false};
+    int nPt_{1};
+    double logPtMin_{0.0};
+    double logPtStep_{1.0};
+    double ptMin_{0.0};
+    double ptMax_{0.0};
+
+    // values_[(iEta * nRho + iRho) * nPt + iPt]
+    CacheArray<double> values_;
+
+    // Owned tables (compiled here) or the cache the views point into
+    std::vector<double> etaEdgesStore_;
+    std::vector<double> rhoEdgesStore_;
+    std::vector<double> valuesStore_;
+    std::shared_ptr<const CorrectionCache> cache_;
+
+    double evaluateRef(double eta, double pt, double rho) const;
+    static std::vector<double> collectEdges(const nlohmann::json& node, const std::string& input);
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+
+// The optional JEC/JER levels of ScaleJetMet as a bit mask, so a chain
+// (e.g. data: L1Rc, L2Rel, L2L3Res; MC: L1Rc, L2Rel, Jer) is a template
+// argument and the per-jet loops carry no flag checks.
+namespace JetLevelChain {
+
+enum Step : unsigned {
+    L1Rc = 1u << 0,
+    L2Rel = 1u << 1,
+    L2L3Res = 1u << 2,
+    Jer = 1u << 3,
+};
+constexpr int nSteps = 4;
+
+// pt, mass *= the factor of every step in kMask, in chain order. Float
+// in and out, as Jet_pt/Jet_mass, so rounding matches scaling the arrays
+template <unsigned kMask>
+inline void advance(float& pt, float& mass, const double* const (&corr)[nSteps], std::size_t k) {
+    if constexpr ((kMask & L1Rc) != 0) { pt *= corr[0][k]; mass *= corr[0][k]; }
+    if constexpr ((kMask & L2Rel) != 0) { pt *= corr[1][k]; mass *= corr[1][k]; }
+    if constexpr ((kMask & L2L3Res) != 0) { pt *= corr[2][k]; mass *= corr[2][k]; }
+    if constexpr ((kMask & Jer) != 0) { pt *= corr[3][k]; mass *= corr[3][k]; }
+}
+
+// Same with the mask known only at run time (reference for benchmark/benchJetChain.cpp)
+inline void advance(unsigned mask, float& pt, float& mass, const double* const (&corr)[nSteps], std::size_t k) {
+    for (int step = 0; step < nSteps; ++step) {
+        if (!(mask & (1u << step))) continue;
+        pt *= corr[step][k];
+        mass *= corr[step][k];
+    }
+}
+
+} // namespace JetLevelChain
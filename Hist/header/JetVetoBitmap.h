@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "correction.h"
+#include "CorrectionCache.h"
+
+// One key of a jet veto map (e.g. "jetvetomap_hot") as a bitset on the
+// native eta x phi binning of the map: bit set <=> correctionlib value > 0.
+//
+// The cell is found with a branch-free binary search over the edges, which
+// gives the same bin as correctionlib (lower edge inclusive). Points outside
+// the map go to correctionlib, so flow behaviour (error) is unchanged.
+class JetVetoBitmap {
+public:
+    // Throws if the key is not a 2D multibinning of numbers, or if the
+    // bitmap disagrees with correctionlib on any tested point
+    JetVetoBitmap(const correction::Correction::Ref& ref, const nlohmann::json& correctionJson,
+                  const std::string& key);
+    JetVetoBitmap(const JetVetoBitmap&) = delete;
+    JetVetoBitmap& operator=(const JetVetoBitmap&) = delete;
+
+    // Sections <prefix>/eta, /phi, /bits, /key
+    void writeTo(CorrectionCacheWriter& writer, const std::string& prefix) const;
+    static std::unique_ptr<JetVetoBitmap> fromCache(const std::shared_ptr<const CorrectionCache>& cache,
+                                                    const std::string& prefix, const correction::Correction::Ref& ref);
+
+    bool isVetoed(double eta, double phi) const;
+
+    // OR over the jets with use[i] != 0, without early exit
+    bool isAnyVetoed(std::size_t n, const float* eta, const float* phi, const std::uint8_t* use) const;
+
+    // Compare with correctionlib at every cell (center and lower corner) and at
+    // nRandom random points; throws on the first difference
+    void validate(int nRandom, unsigned int seed = 12345) const;
+
+    const std::string& getKey() const { return key_; }
+
+private:
+    JetVetoBitmap() = default;
+    correction::Correction::Ref ref_;
+    std::string key_;
+
+    CacheArray<double> etaEdges_;
+    CacheArray<double> phiEdges_;
+    // bit (iEta * nPhi + iPhi)
+    CacheArray<std::uint64_t> bits_;
+
+    std::vector<double> etaEdgesStore_;
+    std::vector<double> phiEdgesStore_;
+    std::vector<std::uint64_t> bitsStore_;
+    std::shared_ptr<const CorrectionCache> cache_;
+
+    bool isVetoedRef(double eta, double phi) const;
+};
@@ -1,15 +1,56 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <sstream>
-#include <ctime>
 #include <string>
+#include <thread>
 
 // Enum to represent log levels
 enum LogLevel { DEBUG, INFO, WARNING, ERROR, CRITICAL };
 
+// Logging macros: the message (anything that can be streamed, e.g.
+// LOG_DEBUG("nJet = " << skimT.nJet)) is only built if the level is enabled.
+// Variadic so that commas in template arguments need no extra parentheses
+#define LOG_AT(level, ...)                                              \
+    do {                                                                \
+        if (Logger::isEnabled(level)) {                                 \
+            std::ostringstream logMessage_;                             \
+            logMessage_ << __VA_ARGS__;                                 \
+            Logger::getInstance().log(level, logMessage_.str());        \
+        }                                                               \
+    } while (0)
+#define LOG_DEBUG(...) LOG_AT(DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(INFO, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_AT(WARNING, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(ERROR, __VA_ARGS__)
+#define LOG_CRITICAL(...) LOG_AT(CRITICAL, __VA_ARGS__)
+
+// Debug print of the classes with an isDebug_ flag and a printDebug(message)
+// member (PickEvent, PickObject*): the message is not built if isDebug_ is off
+#define PRINT_DEBUG(...)                \
+    do {                                \
+        if (isDebug_) {                 \
+            printDebug(__VA_ARGS__);    \
+        }                               \
+    } while (0)
+
+/**
+ * @brief Asynchronous logger.
+ *
+ * log() copies the level, the time and the message into a fixed-size record
+ * of a lock-free ring buffer (a longer message into a heap copy) and returns.
+ * A background thread drains the buffer, formats the time stamp and writes
+ * to the console and the log file.
+ * If the buffer is full the caller waits for a free slot, so no message is
+ * lost. The thread is joined (after writing all pending records) when the
+ * program exits, and around fork() so that forked workers have their own.
+ */
 class Logger {
 public:
     // Get the singleton instance of the logger
@@ -22,32 +63,81 @@ public:
     void LogError(const std::string& message);
     void LogCritical(const std::string& message);
 
+    // General logging function, used by the LOG_* macros
+    void log(LogLevel level, const std::string& message);
+
     // Set the console log level (controls what gets printed to console)
     static void setConsoleLogLevel(LogLevel level);
 
+    // True if a message of this level goes to the console or the log file
+    static bool isEnabled(LogLevel level) {
+        return level >= consoleLogLevel.load(std::memory_order_relaxed) ||
+               hasLogFile.load(std::memory_order_relaxed);
+    }
+
     // Initialize the logger with a file name (called once in main)
     void init(const std::string& filename);
 
+    // Wait until all records logged so far are written
+    void flush();
+    // flush() if the logger exists, e.g. before _exit() in a forked worker
+    static void flushIfCreated();
+
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
 private:
-    std::ofstream logFile;  // File stream for the log file
-    static LogLevel consoleLogLevel;  // Global console log level
-    static Logger* instance;  // Singleton instance
+    // Longer messages are copied to the heap
+    static constexpr std::size_t kTextSize = 224;
+    static constexpr std::size_t kCapacity = 1024;  // power of 2
+
+    struct Record {
+        std::int64_t timeNs;  // system_clock, since epoch
+        char* longText;       // new[]-ed by push() if size > kTextSize, deleted by the writer
+        std::uint32_t size;
+        std::uint8_t level;
+        char text[kTextSize];
+    };
+    // Slot of the bounded multi-producer queue (D. Vyukov): seq == position
+    // if free for the producer at position, position + 1 if filled
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> seq;
+        Record record;
+    };
+
+    std::array<Slot, kCapacity> slots_;
+    alignas(64) std::atomic<std::size_t> head_{0};  // next position to fill
+    alignas(64) std::size_t tail_{0};               // next position to drain (writer thread only)
+    std::atomic<std::size_t> written_{0};           // records written so far
+    std::atomic<bool> stop_{false};
+    std::thread writer_;
+
+    std::ofstream logFile;  // File stream for the log file, writer thread only while it runs
+    static std::atomic<LogLevel> consoleLogLevel;  // Global console log level
+    static std::atomic<bool> hasLogFile;
+    static std::atomic<Logger*> instance_;  // for the fork handlers, null once destroyed
 
     // Private constructor to enforce singleton pattern
-    Logger() {}
+    Logger();
 
-    // General logging function
-    void log(LogLevel level, const std::string& message);
+    void startWriter();
+    void stopWriter();
+    static void beforeFork();
+    static void afterFork();
+
+    void push(LogLevel level, const std::string& message);
+    void writerLoop();
+    void write(const Record& record);
 
     // Converts log level to a string for output
-    std::string levelToString(LogLevel level);
+    static std::string levelToString(LogLevel level);
 
     // Returns ANSI color code based on log level
-    std::string getColorCode(LogLevel level);
+    static std::string getColorCode(LogLevel level);
 
     // Resets ANSI color
-    std::string resetColor();
+    static std::string resetColor();
 };
 
 #endif // LOGGER_H
-
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CutKernels.h"
+#include "SkimTree.h"
+
+// Selection of one object type as an ordered list of threshold cuts on
+// SkimTree arrays, declared once (thresholds from the PickObject*.json
+// values) instead of a hand-written loop per channel:
+//
+//   ObjectCuts muonCuts("Muon", &SkimTree::nMuon);
+//   muonCuts.cut("pt", &SkimTree::Muon_pt, ObjectCuts::Ge, minPt)
+//           .cut("eta", &SkimTree::Muon_eta, ObjectCuts::AbsLe, maxEta);
+//
+// select() applies the cuts one after the other to the candidates that
+// survived the previous ones, each as one loop over one array, and returns
+// the passing indices in increasing order. The values are compared as
+// double, as in the loops this replaces. The number of candidates passing
+// each cut is summed over the job (print()).
+//
+// Busy events (kMaskMinCandidates or more candidates) on AVX-512 CPUs use
+// the CutKernels pass-mask sweeps instead, the only case where they beat
+// the survivor loops (make benchCutKernels).
+class ObjectCuts {
+public:
+    enum Op {
+        Lt, Le, Gt, Ge, Eq, Ne,
+        AbsLt, AbsLe, AbsGt, AbsGe,
+        AbsOutside,  // |x| < value || |x| > value2, e.g. the EB-EE gap
+    };
+
+    template <typename N>
+    ObjectCuts(std::string object, N SkimTree::*count)
+        : object_(std::move(object)),
+          count_([count](const SkimTree& skimT) { return static_cast<std::size_t>(skimT.*count); }) {}
+
+    // Cut on a SkimTree array (Float_t, Int_t, Bool_t, UChar_t, Short_t)
+    template <typename T, std::size_t Size>
+    ObjectCuts& cut(const std::string& name, T (SkimTree::*column)[Size], Op op,
+                    double value, double value2 = 0.0) {
+        Cut c{name, op, value, value2, makeTest(op, value, value2), nullptr, &filterColumn<T>, &sweepColumn<T>};
+        c.column = [column](const SkimTree& skimT) -> const void* { return skimT.*column; };
+        return add(std::move(c));
+    }
+
+    // Cut on a value computed per candidate, e.g. the supercluster eta
+    using Computed = double (*)(const SkimTree& skimT, int i);
+    ObjectCuts& cut(const std::string& name, Computed computed, Op op, double value, double value2 = 0.0);
+
+    // Computed values shared by the PickObject* classes
+    static double electronScEta(const SkimTree& skimT, int i) {
+        return static_cast<double>(skimT.Electron_eta[i]) + skimT.Electron_deltaEtaSC[i];
+    }
+
+    static constexpr std::size_t kMaskMinCandidates = 64;
+
+    // Indices of the candidates passing all cuts, increasing
+    void select(const SkimTree& skimT, std::vector<int>& picked);
+
+    // Candidates and how many passed each cut, summed over all select() calls
+    std::size_t nCuts() const { return cuts_.size(); }
+    long long getNCandidates() const { return nCandidates_; }
+    const std::vector<long long>& getNPass() const { return nPass_; }
+    void print(std::ostream& out) const;
+
+private:
+    struct Cut {
+        std::string name;
+        Op op;
+        double value;
+        double value2;
+        CutKernels::Test test;
+        std::function<const void*(const SkimTree&)> column;
+        // Keeps the indices in idx[0, n) that pass, in order; returns their number
+        std::size_t (*filter)(const Cut& cut, const SkimTree& skimT, int* idx, std::size_t n);
+        // mask[i] &= pass of candidate i, for i < n
+        void (*sweep)(const Cut& cut, const SkimTree& skimT, std::size_t n, std::uint8_t* mask,
+                      std::vector<double>& scratch);
+        Computed computed{nullptr};
+    };
+
+    static CutKernels::Test makeTest(Op op, double value, double value2);
+    ObjectCuts& add(Cut&& c);
+
+    template <typename T>
+    static std::size_t filterColumn(const Cut& cut, const SkimTree& skimT, int* idx, std::size_t n);
+    static std::size_t filterComputed(const Cut& cut, const SkimTree& skimT, int* idx, std::size_t n);
+    template <typename T>
+    static void sweepColumn(const Cut& cut, const SkimTree& skimT, std::size_t n, std::uint8_t* mask,
+                            std::vector<double>& scratch);
+    static void sweepComputed(const Cut& cut, const SkimTree& skimT, std::size_t n, std::uint8_t* mask,
+                              std::vector<double>& scratch);
+
+    void selectSurvivors(const SkimTree& skimT, std::size_t nCand, std::vector<int>& picked);
+    void selectMask(const SkimTree& skimT, std::size_t nCand, std::vector<int>& picked);
+
+    std::string object_;
+    std::function<std::size_t(const SkimTree&)> count_;
+    std::vector<Cut> cuts_;
+    long long nCandidates_{0};
+    std::vector<long long> nPass_;
+    std::vector<std::uint8_t> mask_;
+    std::vector<double> scratch_;  // values of a computed cut
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+// Plain (px, py, pz, E) four-vector for per-event sums that are reset and
+// refilled every event. Same arithmetic as TLorentzVector::SetPtEtaPhiM,
+// Pt(), Phi() and M(), without the TObject overhead.
+struct P4 {
+    double px{0.0};
+    double py{0.0};
+    double pz{0.0};
+    double e{0.0};
+
+    static P4 fromPtEtaPhiM(double pt, double eta, double phi, double m) {
+        return fromPtM(pt, std::cos(phi), std::sin(phi), std::sinh(eta), m);
+    }
+
+    // Same as fromPtEtaPhiM with cos(phi), sin(phi), sinh(eta) computed once
+    // by the caller, for one jet at several correction levels
+    static P4 fromPtM(double pt, double cosPhi, double sinPhi, double sinhEta, double m) {
+        pt = std::abs(pt);
+        const double x = pt * cosPhi;
+        const double y = pt * sinPhi;
+        const double z = pt * sinhEta;
+        const double p2 = x * x + y * y + z * z;
+        return {x, y, z, m >= 0 ? std::sqrt(p2 + m * m) : std::sqrt(std::max(p2 - m * m, 0.0))};
+    }
+
+    double pt() const { return std::sqrt(px * px + py * py); }
+    double phi() const { return (px == 0.0 && py == 0.0) ? 0.0 : std::atan2(py, px); }
+    double m() const {
+        const double mm = e * e - (px * px + py * py + pz * pz);
+        return mm < 0.0 ? -std::sqrt(-mm) : std::sqrt(mm);
+    }
+
+    P4& operator+=(const P4& o) {
+        px += o.px;
+        py += o.py;
+        pz += o.pz;
+        e += o.e;
+        return *this;
+    }
+    P4& operator-=(const P4& o) {
+        px -= o.px;
+        py -= o.py;
+        pz -= o.pz;
+        e -= o.e;
+        return *this;
+    }
+    friend P4 operator+(P4 a, const P4& b) { return a += b; }
+    friend P4 operator-(P4 a, const P4& b) { return a -= b; }
+};
@@ -5,6 +5,7 @@
 #include "SkimTree.h"
 #include "GlobalFlag.h"
 #include "TrigDetail.h"
+#include "TrigRegionTable.h"
 
 class PickEvent{
 public:
@@ -14,8 +15,18 @@ public:
     bool passHlt(const std::shared_ptr<SkimTree>& skimT);
     bool passHltWithPt(const std::shared_ptr<SkimTree>& skimT, const double& pt);
     bool passHltWithPtEta(const std::shared_ptr<SkimTree>& skimT, const double& pt, const double& eta);
-    std::vector<std::string> getPassedHlts(){return passedHlts_;}
-    std::string getPassedHlt(){return passedHlt_;}
+    // Triggers fired in the event, bit = SkimTree::getTrigId(name)
+    const SkimTree::TrigBits& getPassedHltBits() const {return passedHltBits_;}
+    // Trigger passed in passHltWithPt() or passHltWithPtEta()
+    const std::string& getPassedHlt() const;
+    // Position of the trigger passed in passHltWithPt() in getTrigNamesRangePt()
+    // (passHltWithPtEta(): in getTrigNamesRangePtEta())
+    int getPassedHltIndex() const {return passedHltIndex_;}
+    const TrigRangePtEta& getPassedHltRangePtEta() const {return trigsPtEta_[passedHltIndex_].range;}
+    // Triggers of passHltWithPt(), in the order they are tried
+    std::vector<std::string> getTrigNamesRangePt() const;
+    // Triggers of passHltWithPtEta(), in the order they are tried
+    std::vector<std::string> getTrigNamesRangePtEta() const;
     
     std::unordered_map<std::string, const Bool_t*> getTrigValues() const;
 
@@ -31,8 +42,24 @@ private:
     void printDebug(const std::string& message) const;
 
     TrigDetail trigDetail_;
-    std::vector<std::string> passedHlts_{};
-    std::string passedHlt_;
+    // Triggers of passHltWithPt()/passHltWithPtEta() in the order they are
+    // tried. The SkimTree IDs are looked up on the first event (-1: not read)
+    template <typename Range>
+    struct TrigWithRange {
+        std::string name;
+        Range range;
+        int id;
+    };
+    std::vector<TrigWithRange<TrigRangePt>> trigsPt_;
+    std::vector<TrigWithRange<TrigRangePtEta>> trigsPtEta_;
+    // The ranges above as sorted, non-overlapping regions: slot = position
+    TrigRegionTable regionsPt_;
+    TrigRegionTable regionsPtEta_;
+    bool hasTrigIds_{false};
+    void setTrigIds(const SkimTree& skimT);
+
+    SkimTree::TrigBits passedHltBits_;
+    int passedHltIndex_{-1};
 };
 
 #endif // PICKEVENT_H
@@ -15,6 +15,7 @@
 
 #include "SkimTree.h"
 #include "GlobalFlag.h"
+#include "ObjectCuts.h"
 
 class PickObject{
 public:
@@ -82,6 +83,12 @@ private:
     const GlobalFlag::Channel channel_;
     const bool isDebug_;
 
+    // Per-object cuts, thresholds set in the constructor for the channel and year
+    ObjectCuts muonCuts_{"Muon", &SkimTree::nMuon};
+    ObjectCuts electronCuts_{"Electron", &SkimTree::nElectron};
+    ObjectCuts photonCuts_{"Photon", &SkimTree::nPhoton};
+    ObjectCuts jetCuts_{"Jet", &SkimTree::nJet};  // before the photon-jet veto
+
     // Helper function for debug printing
     void printDebug(const std::string& message) const;
 };
@@ -14,6 +14,7 @@
 
 #include "SkimTree.h"
 #include "GlobalFlag.h"
+#include "ObjectCuts.h"
 
 class PickObjectGamJet{
 public:
@@ -86,6 +87,10 @@ private:
     const GlobalFlag::Channel channel_;
     const bool isDebug_;
 
+    // Per-object cuts, built from the configuration
+    ObjectCuts photonCuts_{"Photon", &SkimTree::nPhoton};
+    ObjectCuts jetCuts_{"Jet", &SkimTree::nJet};  // before the photon-jet veto
+
     // Helper function for debug printing
     void printDebug(const std::string& message) const;
 
@@ -14,6 +14,7 @@
 
 #include "SkimTree.h"
 #include "GlobalFlag.h"
+#include "ObjectCuts.h"
 
 class PickObjectZmmJet{
 public:
@@ -92,6 +93,10 @@ private:
     const GlobalFlag::Channel channel_;
     const bool isDebug_;
 
+    // Per-object cuts, built from the configuration
+    ObjectCuts muonCuts_{"Muon", &SkimTree::nMuon};
+    ObjectCuts jetCuts_{"Jet", &SkimTree::nJet};
+
     // Helper function for debug printing
     void printDebug(const std::string& message) const;
 
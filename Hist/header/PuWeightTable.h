@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "correction.h"
+#include "CorrectionCache.h"
+
+// Pileup weights of one event
+struct PuWeights {
+    double nominal{1.0};
+    double up{1.0};
+    double down{1.0};
+};
+
+// The pileup correction ("nominal", "up", "down" x binning in
+// NumTrueInteractions) as one table of {nominal, up, down} per bin, so all
+// three weights come from a single indexed read.
+//
+// Bin lookup follows correctionlib (lower edge inclusive, clamp flow). For
+// any other flow, points outside the binning go to correctionlib.
+class PuWeightTable {
+public:
+    // Throws if the correction is not a category of three plain binnings
+    // with the same edges, or if the table disagrees with correctionlib
+    PuWeightTable(const correction::Correction::Ref& ref, const nlohmann::json& correctionJson);
+    PuWeightTable(const PuWeightTable&) = delete;
+    PuWeightTable& operator=(const PuWeightTable&) = delete;
+
+    // Sections <prefix>/edges, /weights, /clamp
+    void writeTo(CorrectionCacheWriter& writer, const std::string& prefix) const;
+    static std::unique_ptr<PuWeightTable> fromCache(const std::shared_ptr<const CorrectionCache>& cache,
+                                                    const std::string& prefix, const correction::Correction::Ref& ref);
+
+    PuWeights get(double nTrueInt) const;
+    void get(std::size_t n, const float* nTrueInt, PuWeights* out) const;
+
+private:
+    PuWeightTable() = default;
+    correction::Correction::Ref ref_;
+
+    CacheArray<double> edges_;
+    CacheArray<PuWeights> weights_; // one entry per bin
+    bool isClamp_{false};
+    bool isUnitBinning_{false};     // edges are edges[0] + i, bin = floor(x - edges[0])
+
+    std::vector<double> edgesStore_;
+    std::vector<PuWeights> weightsStore_;
+    std::shared_ptr<const CorrectionCache> cache_;
+
+    PuWeights getRef(double nTrueInt) const;
+    void setUnitBinning();
+    void validate() const;
+};
@@ -120,6 +120,7 @@ struct RocRes{
 };
 
 class RoccoR{
+    friend class RoccoRTable;
 
     private:
 	enum TVAR{Default, Replica, Symhes};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "RoccoR.h"
+#include "CorrectionCache.h"
+
+// The nominal set (s = 0, m = 0) of a RoccoR as flat arrays.
+//
+// Same formulas and operation order as RoccoR, so the results are
+// identical; eta bins are found by binary search and phi and
+// tracker-layer bins by direct index instead of linear scans. The tables can be written
+// to the correction cache, so jobs need not parse the 2 MB text file.
+// The replica/systematic sets (and the *error() functions) stay on RoccoR.
+class RoccoRTable {
+public:
+    explicit RoccoRTable(const RoccoR& roccor);
+    RoccoRTable(const RoccoRTable&) = delete;
+    RoccoRTable& operator=(const RoccoRTable&) = delete;
+
+    // Sections <prefix>/meta, /eta, /scale, /resEta, /kRes, /rsPar, /cb
+    void writeTo(CorrectionCacheWriter& writer, const std::string& prefix) const;
+    static std::unique_ptr<RoccoRTable> fromCache(const std::shared_ptr<const CorrectionCache>& cache,
+                                                  const std::string& prefix);
+
+    double kScaleDT(int Q, double pt, double eta, double phi) const;
+    double kScaleMC(int Q, double pt, double eta, double phi) const;
+    double kSpreadMC(int Q, double pt, double eta, double phi, double gt) const;
+    double kSmearMC(int Q, double pt, double eta, double phi, int n, double u) const;
+
+    // Same for n muons at once
+    void kScaleDT(std::size_t n, const int* Q, const float* pt, const float* eta, const float* phi, double* out) const;
+    void kSpreadMC(std::size_t n, const int* Q, const float* pt, const float* eta, const float* phi,
+                   const double* gt, double* out) const;
+    void kSmearMC(std::size_t n, const int* Q, const float* pt, const float* eta, const float* phi,
+                  const int* nl, const double* u, double* out) const;
+
+    // Compare with roccor on nPoints random muons; throws on the first difference
+    void validate(const RoccoR& roccor, int nPoints, unsigned int seed = 12345) const;
+
+private:
+    RoccoRTable() = default;
+
+    enum { MC = 0, DT = 1 }; // RoccoR::TYPE and RocRes::MC/Data
+
+    struct Scale {
+        double M;
+        double A;
+        double X;
+        double k(int Q, double pt) const { return 1.0/(M + Q*A*pt + X/pt); }
+    };
+
+    int nEta_{0};
+    int nPhi_{0};
+    double mPhi_{0.0};
+    double dPhi_{1.0};
+    int nResEta_{0};
+    int nTrk_{0};
+    int nMin_{0};
+
+    CacheArray<double> etaEdges_;    // CETA, nEta_ + 1
+    CacheArray<Scale> scale_;        // [T][H][F]
+    CacheArray<double> resEtaEdges_; // RETA lower edges, nResEta_
+    CacheArray<double> kRes_;        // [H][T]
+    CacheArray<double> rsPar_;       // [H][var][nTrk_]
+    CacheArray<CrystalBall> cb_;     // [H][nTrk_]
+
+    std::vector<double> etaEdgesStore_;
+    std::vector<Scale> scaleStore_;
+    std::vector<double> resEtaEdgesStore_;
+    std::vector<double> kResStore_;
+    std::vector<double> rsParStore_;
+    std::vector<CrystalBall> cbStore_;
+    std::shared_ptr<const CorrectionCache> cache_;
+
+    void setViews();
+    int etaBin(double eta) const;
+    int phiBin(double phi) const;
+    int resEtaBin(double absEta) const;
+    double sigma(double pt, int H, int F) const;
+    double kSpread(double gpt, double rpt, double eta) const;
+    double kExtra(double pt, double eta, int n, double u) const;
+    const Scale& scale(int T, int H, int F) const { return scale_[(T * nEta_ + H) * nPhi_ + F]; }
+};
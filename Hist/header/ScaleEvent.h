@@ -1,6 +1,7 @@
 
 #pragma once 
 
+#include <map>
 #include <set>
 #include <iostream>
 #include <fstream>
@@ -9,6 +10,9 @@
 #include "SkimTree.h"
 #include "correction.h"
 #include "GlobalFlag.h"
+#include "CorrectionCache.h"
+#include "JetVetoBitmap.h"
+#include "PuWeightTable.h"
 
 #include <nlohmann/json.hpp>
 #include <TLorentzVector.h>
@@ -18,6 +22,13 @@ public:
     // Constructor accepting a reference to GlobalFlag
     explicit ScaleEvent(GlobalFlag& globalFlags);
     ~ScaleEvent(){}
+    ScaleEvent(const ScaleEvent&) = delete;
+    ScaleEvent& operator=(const ScaleEvent&) = delete;
+
+    // Take the corrections and lumi tables from a mapped cache (call before the load*)
+    void setCorrectionCache(const std::shared_ptr<const CorrectionCache>& cache);
+    // Add the loaded corrections and lumi tables to a cache ("runMain -C")
+    void writeCorrectionCache(CorrectionCacheWriter& writer) const;
     
     void setNormGenEventSumw(Double_t normGenEventSumw);
     void setLumiWeightInput(double lumiPerYear, double xsec, double nEventsNano);
@@ -37,14 +48,24 @@ public:
     bool checkGoodLumi(const unsigned int& run, const unsigned int& lumi) const;
 
     void loadHltLumiJson();
+    // Reference lookup with the regex "^<hltPathBase>_v\d+$" over all paths (slow)
     double getHltLumiPerRun(const std::string& hltPathBase, const std::string& runNumber) const;
-    double cacheHltLumiPerRun(const std::string& trigName, const double & run) const;
-    // Debugging method to print the cache contents
-    void printRunTriggerLumiCache() const;
+    // ID of a trigger (path without "_v<N>") in the dense table, -1 if not in the JSON.
+    // Resolve once per trigger before the event loop.
+    int getHltLumiTrigId(const std::string& trigName) const;
+    // Recorded lumi of the trigger in the run (0 if it has none), two array reads
+    double getHltLumi(int trigId, unsigned int run) const {
+        if (trigId < 0 || run < hltFirstRun_ || run - hltFirstRun_ >= hltRunIndex_.size()) return 0.0;
+        const int iRun = hltRunIndex_[run - hltFirstRun_];
+        return iRun < 0 ? 0.0 : hltLumiTable_[static_cast<std::size_t>(trigId) * hltNRuns_ + iRun];
+    }
 
     // Pileup
     void loadPuRef();
     double getPuCorrection(Float_t nTrueInt, const std::string& nomOrSyst) const;
+    // nominal, up and down in one lookup; batch form for a block of events
+    PuWeights getPuWeights(Float_t nTrueInt) const;
+    void getPuWeights(std::size_t n, const Float_t* nTrueInt, PuWeights* out) const;
 
 private:
 
@@ -53,29 +74,63 @@ private:
     std::string jetVetoName_;
     std::string jetVetoKey_;
     correction::Correction::Ref loadedJetVetoRef_;
+    // jetVetoKey_ of the map as a bitset, nullptr if the map cannot be rasterized
+    std::unique_ptr<JetVetoBitmap> jetVetoBitmap_;
     
     // Lumi
     double lumiWeight_;
     double lumiPerEra_;
     std::string goldenLumiJsonPath_;
-    nlohmann::json loadedGoldenLumiJson_;
+    // Golden JSON as merged lumi ranges sorted by (run, first)
+    struct LumiRange {
+        std::uint32_t run;
+        std::uint32_t first;
+        std::uint32_t last;
+    };
+    std::vector<LumiRange> goldenLumiStore_;
+    CacheArray<LumiRange> goldenLumi_;
+    // Skims are run ordered: ranges of the last run and the last (run, lumi) answer
+    mutable std::uint32_t memoRun_{0};
+    mutable const LumiRange* memoRunBegin_{nullptr};
+    mutable const LumiRange* memoRunEnd_{nullptr};
+    mutable std::uint32_t memoLumi_{0};
+    mutable bool memoIsGood_{false};
 
     // Lumi
     std::string hltLumiJsonPath_;
-    nlohmann::json loadedHltLumiJson_;
-
-    // Two-level cache: run -> (trigger -> recorded luminosity)
-    mutable std::unordered_map<int, std::unordered_map<std::string, double>> run2Trig2Lumi_;
-
+    // First valid "recorded" per (HLT path, run), sorted by (path, run).
+    // path indexes hltPaths_, which is in the (sorted) order of the JSON.
+    struct HltLumiRecord {
+        std::uint32_t path;
+        std::uint32_t run;
+        double recorded;
+    };
+    std::vector<std::string> hltPaths_;
+    std::vector<HltLumiRecord> hltLumiStore_;
+    CacheArray<HltLumiRecord> hltLumi_;
+
+    // Dense table [trigId][run index] from the records: for each trigger the
+    // first path (in JSON order) with a record of the run, as getHltLumiPerRun
+    std::map<std::string, int> hltTrigIds_;
+    std::vector<int> hltRunIndex_; // run - hltFirstRun_ -> run index, -1 if absent
+    std::uint32_t hltFirstRun_{0};
+    std::size_t hltNRuns_{0};
+    std::vector<double> hltLumiTable_;
+    void buildHltLumiTable();
 
     // Pileup
     std::string puJsonPath_;
     std::string puName_;
     correction::Correction::Ref loadedPuRef_;
+    // nullptr if the correction cannot be tabulated
+    std::unique_ptr<PuWeightTable> puWeightTable_;
     
     double minbXsec_{};
     Double_t normGenEventSumw_;
 
+    std::shared_ptr<const CorrectionCache> cache_;
+    auto loadCorrection(const std::string& jsonPath, const std::string& name) const -> correction::Correction::Ref;
+
     // Reference to GlobalFlag instance
     GlobalFlag& globalFlags_;
     const GlobalFlag::Year year_;
@@ -1,12 +1,15 @@
 #ifndef SCALEJETMET_H
 #define SCALEJETMET_H
 
-#include <unordered_map>
+#include <array>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 #include "SkimTree.h"
 #include "ScaleObject.h"
-#include "TLorentzVector.h"
+#include "P4.h"
+#include "JetLevelChain.h"
 
 /**
  * @brief Class to apply Jet Energy Corrections (JEC) to jets in an event.
@@ -22,48 +25,78 @@ public:
         L2L3Res = 3
     };
 
+    // Jet p4 after each step of the chain; Corr is the final one.
+    // The MET is filled for Nano and Corr only.
+    enum Level { Nano, Raw, L1RcCorr, L2RelCorr, L2L3ResCorr, JerCorr, Corr, nLevels };
+    static constexpr std::array<const char*, nLevels> levelNames{
+        "Nano", "Raw", "L1RcCorr", "L2RelCorr", "L2L3ResCorr", "JerCorr", "Corr"};
+
+    // Picks the chain of each CorrectionLevel once: no isData/applyJer/level
+    // checks per event or jet after that
     ScaleJetMet(ScaleObject *scaleObj, bool isData, bool applyJer);
     
     void Initialize();
     void applyCorrections(std::shared_ptr<SkimTree>& skimT, CorrectionLevel level);
 
-    // Getter functions to access the corrections maps
-    const std::unordered_map<std::string, TLorentzVector>& getP4MapJet1() const {
-        return p4MapJet1_;
-    }
-    const std::unordered_map<std::string, TLorentzVector>& getP4MapJetSum() const {
-        return p4MapSelJetSum_;
-    }
-
-    const std::unordered_map<std::string, TLorentzVector>& getP4MapMet() const {
-        return p4MapMet_;
-    }
+    // Leading jet, sum of the selected jets and MET per level. Nano and Corr
+    // are filled by applyCorrections; the intermediate levels only on the
+    // first call of the event that asks for one (see sumLevels)
+    const P4& getP4Jet1(Level level) const { sumLevels(level); return p4Jet1_[level]; }
+    const P4& getP4JetSum(Level level) const { sumLevels(level); return p4SelJetSum_[level]; }
+    const P4& getP4Met(Level level) const { return p4Met_[level]; }
 
     void print() const;
 
 private:
+    // One instantiation per set of levels (JetLevelChain mask)
+    using Chain = void (ScaleJetMet::*)(SkimTree&);
+    template <unsigned kMask> void runChain(SkimTree& skimT);
+    template <unsigned... kMasks>
+    static constexpr std::array<Chain, sizeof...(kMasks)> makeChains(std::integer_sequence<unsigned, kMasks...>);
+
     ScaleObject *scaleObj_;
     bool isData_;
     bool applyJer_;
 
     //For debug
-    TLorentzVector p4SumAllNano_;
-    TLorentzVector p4SumCorrAndUnCorr_;
+    P4 p4SumAllNano_;
+    P4 p4SumCorrAndUnCorr_;
 
+    // Reset every event, no allocation
+    mutable std::array<P4, nLevels> p4Jet1_;
+    mutable std::array<P4, nLevels> p4SelJetSum_;
+    std::array<P4, nLevels> p4Met_;
+    mutable bool hasLevelSums_{false};
 
-    // Jet correction maps
-    std::unordered_map<std::string, TLorentzVector> p4MapJet1_;
-    std::unordered_map<std::string, TLorentzVector> p4MapSelJetSum_;
+    static constexpr int nCorrectionLevels = static_cast<int>(CorrectionLevel::L2L3Res) + 1;
+    std::array<Chain, nCorrectionLevels> chains_{};
+    static Chain chainFor(unsigned mask);
+    // sumLevelsOf<kMask> of the chain that ran last
+    void (ScaleJetMet::*sumLevels_)() const = nullptr;
 
-    // MET
-    std::unordered_map<std::string, TLorentzVector> p4MapMet_;
+    // Jets with pt > 15 and |eta| < 5.2, gathered for the batched ScaleObject calls.
+    // The buffers are kept between events to avoid reallocations.
+    std::vector<int> selIndex_;
+    std::vector<float> eta_, phi_, area_, ptNano_, massNano_;
+    std::vector<Short_t> genJetIdx_;
+    std::vector<float> rawScale_;  // 1 - Jet_rawFactor
+    std::vector<float> pt_;        // pt after the last applied level, input of the next one
+    // Factor of each applied level (L1RcCorr ... JerCorr)
+    std::array<std::vector<double>, nLevels> corrStep_;
+    std::array<bool, nLevels> hasStep_{};
 
-    // Internal methods for correction steps
-    void undoNanoAODCorrection(SkimTree& skimT, int i);
-    void applyL1FastJetCorrection(SkimTree& skimT, int i);
-    void applyL2RelativeCorrection(SkimTree& skimT, int i);
-    void applyL2L3ResidualCorrection(SkimTree& skimT, int i);
-    void applyJerCorrection(SkimTree& skimT, int i);
+    void gatherJets(const SkimTree& skimT);
+    void applyStep(Level step);    // pt_ *= corrStep_[step]
+    // One pass over all jets: final pt/mass, the Nano and Corr sums and the
+    // Type-1 MET, with the jet trigonometry computed once
+    template <unsigned kMask> void sumJetsAndMet(SkimTree& skimT);
+    // Sums of the intermediate levels (Raw ... JerCorr), memoized per event.
+    // Only HistScale and print() read them, so events that stop before
+    // (or channels that never fill HistScale) skip this pass.
+    void sumLevels(Level level) const;
+    template <unsigned kMask> void sumLevelsOf() const;
+    // isDebug: redo the sums level by level with P4::fromPtEtaPhiM and compare
+    void validateSums(const SkimTree& skimT) const;
 };
 
 #endif // SCALEJETMET_H
@@ -8,10 +8,12 @@
 
 #include "SkimTree.h"
 #include "correction.h"
+#include "JercGrid.h"
+#include "CorrectionCache.h"
 #include "RoccoR.h"
+#include "RoccoRTable.h"
 #include "GlobalFlag.h"
 
-#include "TRandom3.h"
 #include <nlohmann/json.hpp>
 
 class ScaleObject{
@@ -22,6 +24,12 @@ public:
     
     // Load configuration from JSON file
     void loadConfig(const std::string& filename);
+    bool isDebug() const { return isDebug_; }
+
+    // Take the JERC corrections and grids from a mapped cache (call before the load*Ref)
+    void setCorrectionCache(const std::shared_ptr<const CorrectionCache>& cache);
+    // Add the loaded JERC corrections, their grids and the Rochester table to a cache ("runMain -C")
+    void writeCorrectionCache(CorrectionCacheWriter& writer) const;
 
     // L1 Offset (aka PU or L1RC) correction
     void loadJetL1FastJetRef();
@@ -45,20 +53,39 @@ public:
 
     // now corrJer using resoJer and sfJer
     double getJerCorrection(const SkimTree& skimT, int index, const std::string& syst) const;
+
+    // Batched versions for n jets of one event (e.g. the jets selected in ScaleJetMet),
+    // one call per level. Inputs are plain arrays, corr[i] is filled for i < n.
+    void getL1FastJetCorrections(std::size_t n, const float* jetArea, const float* jetEta, const float* jetPt,
+                                 double rho, double* corr) const;
+    void getL2RelativeCorrections(std::size_t n, const float* jetEta, const float* jetPt, double* corr) const;
+    void getL2L3ResidualCorrections(std::size_t n, const float* jetEta, const float* jetPt, double* corr) const;
+    // GenJet matching uses the GenJet arrays of skimT; jetIndex (position in Jet_*) and
+    // the event numbers of skimT key the smearing random numbers
+    void getJerCorrections(const SkimTree& skimT, std::size_t n, const int* jetIndex, const float* jetEta,
+                           const float* jetPt, const float* jetPhi, const Short_t* genJetIdx,
+                           const std::string& syst, double* corr) const;
     
     // Photon Scale and Smearing (Ss)
     void loadPhoSsRef();
     double getPhoScaleCorrection(const SkimTree& skimT, const std::string& nomOrSyst,  int indexPho) const;
     double getPhoSmearCorrection(const SkimTree& skimT, const std::string& nomOrSyst,  int indexPho) const;
+    // All skimT.nPhoton photons at once (EgmSsKernel), corr[i] is filled for i < nPhoton
+    void getPhoScaleCorrections(const SkimTree& skimT, const std::string& nomOrSyst, double* corr) const;
+    void getPhoSmearCorrections(const SkimTree& skimT, const std::string& nomOrSyst, double* corr) const;
 
     // Muon Rochester correction 
     void loadMuRochRef();
     double getMuRochCorrection(const SkimTree& skimT, int index, const std::string& syst) const;
+    // Nominal correction of all skimT.nMuon muons into corr
+    void getMuRochCorrections(const SkimTree& skimT, double* corr) const;
     
     // Electron Scale and Smearing (Ss):  ONLY Syst. Nominal corrections are already applied in Nano
     // https://cms-talk.web.cern.ch/t/electron-scale-and-smearing-uncertainties-in-nanoaod/9311
     void loadEleSsRef();
     double getEleSsCorrection(const SkimTree& skimT, int index, const std::string& syst) const;
+    // All skimT.nElectron electrons at once (EgmSsKernel)
+    void getEleSsCorrections(const SkimTree& skimT, double* corr) const;
     
 private:
 
@@ -87,7 +114,6 @@ private:
     // sfJer 
     std::string JerSfName_;
     correction::Correction::Ref loadedJerSfRef_;
-	std::unique_ptr<TRandom> randomNumGen = std::make_unique<TRandom3>(0);
     
     // Photon Scale and Smearing (Ss)
     std::string phoSsJsonPath_;
@@ -102,6 +128,25 @@ private:
     // Muon rochester corrections 
     std::string muRochJsonPath_;
     RoccoR loadedRochRef_; 
+    // Nominal set as flat tables, from the cache or built from loadedRochRef_ (then the text file is not parsed)
+    std::unique_ptr<RoccoRTable> rochTable_;
+    double getMuRochGenPt(const SkimTree& skimT, int index) const;
+
+    // Dense tables for L2Relative, L2L3Residual, JER reso and SF (opt-in, "jercGrid" in the config)
+    bool useJercGrid_{false};
+    int nJercGridValidate_{0};
+    JercGrid::Options jercGridOptions_;
+    std::unique_ptr<JercGrid> jetL2RelativeGrid_;
+    std::unique_ptr<JercGrid> jetL2L3ResidualGrid_;
+    std::unique_ptr<JercGrid> jerResoGrid_;
+    std::unique_ptr<JercGrid> jerSfGrid_;
+    auto buildJercGrid(const correction::Correction::Ref& ref, const std::string& name,
+                       const std::string& category = "") const -> std::unique_ptr<JercGrid>;
+    auto makeJercGrid(const correction::Correction::Ref& ref, const std::string& name,
+                      const std::string& category) const -> std::unique_ptr<JercGrid>;
+
+    std::shared_ptr<const CorrectionCache> cache_;
+    auto loadJercCorrection(const std::string& name) const -> correction::Correction::Ref;
 
     // Reference to GlobalFlag instance
     GlobalFlag& globalFlags_;
@@ -4,13 +4,17 @@
 #include <string>
 #include <vector>
 #include <nlohmann/json.hpp>
+#include <Rtypes.h>
 
 #include "GlobalFlag.h"
 
 class SkimFile {
 public:
     // Constructor accepting a reference to GlobalFlag
-    explicit SkimFile(GlobalFlag& globalFlags, const std::string& outName, const std::string& inJsonDir);
+    // splitByFiles = false leaves the job selection to setEntryRange()
+    // isNanoInput = true takes the files from FilesNano_<Channel>_<Year>.json
+    explicit SkimFile(GlobalFlag& globalFlags, const std::string& outName, const std::string& inJsonDir,
+                      bool splitByFiles = true, bool isNanoInput = false);
     ~SkimFile() noexcept;
 
     // Delete copy constructor and assignment operator since the class holds references.
@@ -21,6 +25,7 @@ public:
 
     void setInputJsonPath(const std::string& inDir);
     void loadInputJson();
+    void loadNanoFileNames();
 
     [[nodiscard]] const std::string& getSampleKey() const { 
         return loadedSampKey_; 
@@ -36,6 +41,26 @@ public:
         return loadedJobFileNames_; 
     }
 
+    // Per-file entry catalog of the full sample, cached in a JSON file
+    void loadFileEntries(const std::string& cacheFilePath);
+
+    // Select the files overlapping the global entry range [begin, end)
+    void setEntryRange(Long64_t begin, Long64_t end);
+
+    // Balanced shard NofM of the sample, in entries instead of files
+    void setBalancedEntryRange();
+
+    [[nodiscard]] Long64_t getTotalEntries() const;
+
+    // Entry range relative to the first file of getJobFileNames()
+    [[nodiscard]] Long64_t getJobEntryBegin() const { 
+        return jobEntryBegin_; 
+    }
+
+    [[nodiscard]] Long64_t getJobEntryEnd() const { 
+        return jobEntryEnd_; 
+    }
+
     [[nodiscard]] const double & getXsecOrLumiNano() const { 
         return nanoXssOrLumi_; 
     }
@@ -50,10 +75,19 @@ private:
     std::string loadedSampKey_ = "MC_Year_Channel_Name";
     int loadedNthJob_ = 1;
     int loadedTotJob_ = 100;
+    int nameTotJob_ = 100; // M of NofM as given, never clamped
+    bool isNanoInput_ = false;
     std::string inputJsonPath_ = "./FilesSkim_2022_GamJet.json";
     std::vector<std::string> loadedAllFileNames_;
     std::vector<std::string> loadedJobFileNames_;
 
+    // Entries per file, same order as loadedAllFileNames_
+    std::vector<Long64_t> loadedFileEntries_;
+    Long64_t jobEntryBegin_ = 0;
+    Long64_t jobEntryEnd_ = -1;
+
+    static Long64_t countEntries(const std::string& fileName);
+
     // Reference to GlobalFlag instance and related constant members
     GlobalFlag& globalFlags_;
     const GlobalFlag::Year year_;
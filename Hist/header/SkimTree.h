@@ -4,8 +4,16 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TChain.h>
+#include <TBranch.h>
+#include <TDirectory.h>
+#include <array>
+#include <bitset>
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "GlobalFlag.h"
 #include "TrigDetail.h"
@@ -22,7 +30,34 @@ public:
     Int_t getEntry(Long64_t entry);
     Long64_t loadEntry(Long64_t entry);
 
+    // Read all bound branches/fields of the entry returned by loadEntry()
+    void readEntry(Long64_t localEntry);
+
+    // Skims are read as TTree or, if the file holds an RNTuple 'Events'
+    // (Skim run with -f rntuple), through the RNTuple backend. Decided from
+    // the first file; the rest of the file list must have the same format.
     void loadTree(std::vector<std::string> skimFileList);
+    [[nodiscard]] bool isRNTuple() const { return isRNTuple_; }
+    static bool isRNTupleFile(const std::string& fileName);
+    static Long64_t countNTupleEntries(const std::string& fileName);
+
+    // Direct-from-NanoAOD input: call before loadTree(). Reads only the
+    // branches the Skim would keep and applies its filters and triggers
+    // (same lists, same order) in memory through passSkimSelection().
+    void setSkimSelection(const std::string& commonConfigPath, const std::string& channelConfigPath);
+    [[nodiscard]] bool isNanoInput() const { return isNanoInput_; }
+
+    // Always true for skim input. For NanoAOD input only the filter and
+    // trigger branches of the current entry are read, like in the Skim.
+    bool passSkimSelection(Long64_t ientry);
+
+    // The NanoAOD/Filter/Trigger cutflow a Skim job would have written
+    void writeSkimCutflow(TDirectory* dir) const;
+
+    // Restrict the loop to chain entries [begin, end), both edges moved down
+    // to the start of their TTree cluster. getEntries() and loadEntry() then
+    // work relative to the aligned begin.
+    void setEntryRange(Long64_t begin, Long64_t end);
 
     // Accessors for tree variables (public for direct access)
     // {} in the end is to initialise
@@ -83,8 +118,16 @@ public:
     Float_t Photon_energyErr[nPhotonMax]{};
 
     //HLT
-    std::vector<std::string> getTrigNames() const {return trigNames_;}
+    // Triggers are interned at startup: the ID of a trigger is its position
+    // in getTrigNames(), and the decisions of an event are one bit per ID
+    static constexpr std::size_t maxTrigs = 64;
+    using TrigBits = std::bitset<maxTrigs>;
+    const std::vector<std::string>& getTrigNames() const {return trigNames_;}
     Bool_t getTrigValue(const std::string& trigName) const;
+    Bool_t getTrigValue(int trigId) const {return trigValues_[trigId] != 0;}
+    // -1 if the trigger is not read
+    int getTrigId(const std::string& trigName) const;
+    TrigBits getTrigBits() const;
 
     // Gen photon variables
     UInt_t nGenIsolatedPhoton{};
@@ -158,9 +201,64 @@ public:
 private:
 
     Int_t fCurrent_; // Current Tree number in a TChain
+    Long64_t entryOffset_{0};
+    Long64_t entryCount_{-1}; // -1: whole chain
+    Long64_t alignToCluster(Long64_t entry);
 
     // ROOT TChain
     std::unique_ptr<TChain> fChain_;
+    Long64_t getChainEntries() const;
+
+    // Every event-model variable goes through bindBranch(): a TTree branch
+    // address, or a field copied into the same variable by readEntry().
+    enum class ColumnType { Bool, Char, UChar, Short, Int, UInt, ULong64, Float };
+    template <typename T>
+    static constexpr auto columnTypeOf() -> ColumnType {
+        if constexpr (std::is_same_v<T, Bool_t>) return ColumnType::Bool;
+        else if constexpr (std::is_same_v<T, char>) return ColumnType::Char; // HLT flags, see trigValues_
+        else if constexpr (std::is_same_v<T, UChar_t>) return ColumnType::UChar;
+        else if constexpr (std::is_same_v<T, Short_t>) return ColumnType::Short;
+        else if constexpr (std::is_same_v<T, Int_t>) return ColumnType::Int;
+        else if constexpr (std::is_same_v<T, UInt_t>) return ColumnType::UInt;
+        else if constexpr (std::is_same_v<T, ULong64_t>) return ColumnType::ULong64;
+        else if constexpr (std::is_same_v<T, Float_t>) return ColumnType::Float;
+        else static_assert(sizeof(T) == 0, "Unsupported branch type in SkimTree");
+    }
+    struct NTupleBinding {
+        std::string name;
+        void* address;
+        ColumnType type;
+        std::size_t length; // capacity of the array, 1 for scalars
+        bool isArray;
+    };
+    std::vector<NTupleBinding> ntupleBindings_;
+
+    template <typename T>
+    void bindBranch(const std::string& name, T* address) {
+        if (!isRNTuple_) {
+            fChain_->SetBranchAddress(name.c_str(), address);
+            return;
+        }
+        ntupleBindings_.push_back({name, address, columnTypeOf<T>(), 1, false});
+    }
+    template <typename T, std::size_t N>
+    void bindBranch(const std::string& name, T (*address)[N]) {
+        if (!isRNTuple_) {
+            fChain_->SetBranchAddress(name.c_str(), address);
+            return;
+        }
+        ntupleBindings_.push_back({name, *address, columnTypeOf<T>(), N, true});
+    }
+
+    // RNTuple backend: one reader per file, views rebuilt on file change
+    bool isRNTuple_{false};
+    std::vector<std::string> ntupleFiles_;
+    std::vector<Long64_t> ntupleEntryEdges_{0}; // cumulative entries, files + 1
+    int ntupleCurrent_{-1};
+    std::shared_ptr<void> ntupleReader_;        // RNTupleReader of ntupleCurrent_
+    std::vector<std::function<void(Long64_t)>> ntupleReads_;
+    bool addNTupleFile(const std::string& fullPath);
+    void openNTupleFile(int index);
 
     // Disable copying and assignment
     SkimTree(const SkimTree&) = delete;
@@ -173,6 +271,19 @@ private:
     std::unordered_map<std::string, size_t> trigNameToIndex_;
     void initializeTriggers();
 
+    // Skim selection for NanoAOD input
+    bool isNanoInput_{false};
+    std::vector<std::string> skimBranches_;
+    std::vector<std::string> skimFilterNames_;
+    std::vector<std::string> skimTrigNames_;
+    std::vector<char> skimFilterValues_;
+    std::vector<char> skimTrigStorage_;   // for Skim triggers unknown to TrigDetail
+    std::vector<char*> skimTrigValues_;   // into trigValues_ or skimTrigStorage_
+    std::vector<TBranch*> skimFilterBranches_;
+    std::vector<TBranch*> skimTrigBranches_;
+    std::array<Long64_t, 3> skimCutflow_{}; // NanoAOD, Filter, Trigger
+    void bindSkimSelection();
+
     // Reference to GlobalFlag instance
     GlobalFlag& globalFlags_;
     const GlobalFlag::Year year_;
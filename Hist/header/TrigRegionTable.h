@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// The pt (x |eta|) ranges of the triggers of TrigDetail compiled into a
+// grid over the sorted range edges, with the trigger that owns each cell.
+// find() is one binary search per axis instead of a loop over all ranges.
+//
+// The ranges must not overlap: the owner of a point would otherwise depend
+// on the order the triggers are tried, so the constructor throws. Gaps
+// inside the covered region are printed as warnings.
+class TrigRegionTable {
+public:
+    struct Region {
+        std::string name;
+        double ptMin;
+        double ptMax;
+        double absEtaMin;
+        double absEtaMax;
+    };
+
+    TrigRegionTable() = default;  // no regions: find() gives -1
+    // The slot of a region is its position in regions
+    explicit TrigRegionTable(const std::vector<Region>& regions);
+
+    // Slot of the region with ptMin <= pt < ptMax and absEtaMin <= |eta| < absEtaMax,
+    // -1 if none
+    int find(double pt, double absEta = 0.0) const;
+
+    bool empty() const { return cellSlot_.empty(); }
+
+private:
+    std::vector<double> ptEdges_;
+    std::vector<double> etaEdges_;
+    std::vector<int> cellSlot_;  // [iPt * nEtaBins + iEta]
+
+    int nEtaBins() const { return static_cast<int>(etaEdges_.size()) - 1; }
+};
@@ -55,6 +55,9 @@ if __name__=="__main__":
             print(f"{ch}: {year}:  {sKey}: nJob = {nJob}")
         print(f"\n{ch}: {year} :  nJobs  = {yJobs}\n")
         allJobs = allJobs + yJobs
+        #NanoAOD file lists, for runMain -N (direct-from-NanoAOD mode)
+        if os.path.exists(f"{skimDir}/FilesNano_{ch}_{year}.json"):
+            os.system(f"cp {skimDir}/FilesNano_{ch}_{year}.json json/")
         fSkimNew = open(f"json/FilesSkim_{ch}_{year}.json", "w")
         json.dump(jSkim, fSkimNew, indent=4) 
         json.dump(dHist, fHist, indent=4) 
@@ -15,10 +15,15 @@
 #include "ScaleObject.h"
 #include "GlobalFlag.h"
 #include "Helper.h"
+#include "ForkServer.h"
+#include "CorrectionRegistry.h"
+#include "CorrectionCache.h"
 
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <filesystem>
+#include <sstream>
+#include <chrono>
 #include <nlohmann/json.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -28,6 +33,162 @@
 using namespace std;
 namespace fs = std::filesystem;
 
+namespace {
+
+// Corrections, lumi and trigger tables are loaded once for these flags,
+// every job sharing them must agree on them.
+bool isCompatible(const GlobalFlag& a, const GlobalFlag& b) {
+    return a.getYear() == b.getYear() && a.getEra() == b.getEra() &&
+           a.getChannel() == b.getChannel() && a.isData() == b.isData();
+}
+
+// Produces one output file. The sample and job specific parts (file list,
+// entry range, normalisation, tree) are rebuilt here, the loaded
+// ScaleEvent/ScaleObject/PickEvent/PickObject are reused.
+int runJob(const GlobalFlag& baseFlag, const std::string& outName, const std::string& entryRange,
+           const std::string& inJsonDir, bool isNanoInput, ScaleEvent* scaleEvent, ScaleObject* scaleObj, PickEvent* pickEvent, PickObject* pickObject) {
+
+    Helper::printBanner("Set GlobalFlag.cpp for " + outName);
+    GlobalFlag globalFlag(outName);
+    globalFlag.setDebug(baseFlag.isDebug());
+    globalFlag.setNDebug(baseFlag.getNDebug());
+    if (!isCompatible(globalFlag, baseFlag)) {
+        std::cerr << "Critical error: " << outName 
+                  << " needs other year, era, channel or data/MC than the loaded corrections" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Helper::printBanner("Set and load SkimFile.cpp");
+    const bool splitByFiles = entryRange.empty();
+    std::shared_ptr<SkimFile> skimF = std::make_shared<SkimFile>(globalFlag, outName, inJsonDir,
+                                                                 splitByFiles, isNanoInput);
+    if (!splitByFiles) {
+        try {
+            skimF->loadFileEntries("config/SkimEntries.json");
+            if (entryRange == "auto") {
+                skimF->setBalancedEntryRange();
+            } else {
+                const std::vector<std::string> edges = Helper::splitString(entryRange, ":");
+                if (edges.size() != 2) {
+                    throw std::runtime_error("Invalid -e " + entryRange + ": expected start:end or auto");
+                }
+                skimF->setEntryRange(std::stoll(edges.at(0)), std::stoll(edges.at(1)));
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Critical error: " << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    Helper::printBanner("Set and load RunsTree.cpp");
+    std::shared_ptr<RunsTree> runsT = std::make_shared<RunsTree>(globalFlag);
+    Double_t normGenEventSumw = 1.0; 
+    if (globalFlag.isMC()) {
+        std::string cacheFilePath = "config/RunsTree.json";
+        normGenEventSumw = runsT->getCachedNormGenEventSumw(skimF->getSampleKey(), 
+                                                     cacheFilePath, 
+                                                     skimF->getAllFileNames());
+    }
+
+    Helper::printBanner("Set and load SkimTree.cpp");
+    std::shared_ptr<SkimTree> skimT = std::make_shared<SkimTree>(globalFlag);
+    if (isNanoInput) {
+        // The Skim package sits next to Hist in this repository
+        const std::string skimConfigDir = "../Skim/config/";
+        skimT->setSkimSelection(skimConfigDir + "ReadConfigCommon.json",
+                                skimConfigDir + "ReadConfig" + globalFlag.getChannelStr() + ".json");
+    }
+    skimT->loadTree(skimF->getJobFileNames());
+    if (!splitByFiles) {
+        skimT->setEntryRange(skimF->getJobEntryBegin(), skimF->getJobEntryEnd());
+    }
+
+    Helper::printBanner("Set sample weights in ScaleEvent.cpp");
+    if (globalFlag.isData()) {
+        scaleEvent->setLumiPerEra(skimF->getXsecOrLumiNano());
+    }else{
+        scaleEvent->setNormGenEventSumw(normGenEventSumw);
+        scaleEvent->setLumiWeightInput(globalFlag.getLumiPerYear(), skimF->getXsecOrLumiNano(), skimF->getEventsNano());
+    }
+
+    std::string outDir = "output";
+    mkdir(outDir.c_str(), S_IRWXU);
+    auto fout = std::make_unique<TFile>((outDir + "/" + outName).c_str(), "RECREATE");
+
+    Helper::printBanner("Loop over events and fill Histos");
+
+    if (globalFlag.getChannel() == GlobalFlag::Channel::ZeeJet) {
+        std::cout << "==> Running ZeeJet" << std::endl;
+        auto zeeJet = std::make_unique<RunZeeJet>(globalFlag);
+        zeeJet->Run(skimT, pickEvent, scaleEvent, scaleObj, fout.get());
+    }
+    if (globalFlag.getChannel() == GlobalFlag::Channel::ZmmJet) {
+        std::cout << "==> Running ZmmJet" << std::endl;
+        auto zmmJet = std::make_unique<RunZmmJet>(globalFlag);
+        zmmJet->Run(skimT, pickEvent, scaleEvent, scaleObj, fout.get());
+    }
+
+    if (globalFlag.getChannel() == GlobalFlag::Channel::GamJet) {
+        std::cout << "==> Running GamJet" << std::endl;
+        auto gamJet = std::make_unique<RunGamJet>(globalFlag);
+        gamJet->Run(skimT, pickEvent, scaleEvent, scaleObj, fout.get());
+    }
+    if (globalFlag.getChannel() == GlobalFlag::Channel::GamJetFake) {
+        std::cout << "==> Running GamJetFake" << std::endl;
+        auto gamJetFake = std::make_unique<RunGamJetFake>(globalFlag);
+        gamJetFake->Run(skimT, pickEvent, pickObject, scaleEvent, scaleObj, fout.get());
+    }
+
+    if (globalFlag.getChannel() == GlobalFlag::Channel::MultiJet) {
+        std::cout << "==> Running MultiJet" << std::endl;
+        auto multiJet = std::make_unique<RunMultiJet>(globalFlag);
+        multiJet->Run(skimT, pickEvent, pickObject, scaleEvent, scaleObj, fout.get());
+    }
+    if (globalFlag.getChannel() == GlobalFlag::Channel::Wqqe) {
+        std::cout << "==> Running Wqqe" << std::endl;
+        auto wqqe = std::make_unique<RunWqqe>(globalFlag);
+        wqqe->Run(skimT, pickEvent, pickObject, scaleEvent, scaleObj, fout.get());
+    }
+    if (globalFlag.getChannel() == GlobalFlag::Channel::Wqqm) {
+        std::cout << "==> Running Wqqm" << std::endl;
+        auto wqqm = std::make_unique<RunWqqm>(globalFlag);
+        wqqm->Run(skimT, pickEvent, pickObject, scaleEvent, scaleObj, fout.get());
+    }
+    skimT->writeSkimCutflow(fout.get());
+/*
+
+  if (globalFlag->isMCTruth) {
+    std::cout << "==> Running MCTruth" << std::endl;
+    auto mcTruth = std::make_unique<RunMCTruth>(outName);
+    mcTruth->Run(skimT.get(), pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
+  }
+  if (globalFlag->isFlavour) {
+    std::cout << "==> Running Flavour" << std::endl;
+    auto mcFlavour = std::make_unique<RunFlavour>(outName);
+    mcFlavour->Run(skimT.get(), pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
+  }
+  if (globalFlag->isVetoMap) {
+    std::cout << "==> Running VetoMap" << std::endl;
+    auto vetoMap = std::make_unique<RunVetoMap>(outName);
+    vetoMap->Run(skimT.get(), pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
+  }
+  if (globalFlag->isIncJet) {
+    std::cout << "==> Running IncJet" << std::endl;
+    auto incJet = std::make_unique<RunIncJet>(outName);
+    incJet->Run(skimT.get(), pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
+  }
+  if (globalFlag->isDiJet) {
+    std::cout << "==> Running DiJet" << std::endl;
+    auto diJet = std::make_unique<RunDiJet>(outName);
+    diJet->Run(skimT.get(), pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
+  }
+  */
+
+    return 0;
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
 
     /*
@@ -67,16 +228,52 @@ int main(int argc, char* argv[]) {
 
   nlohmann::json js;
   std::string outName;
+  std::string entryRange; // "start:end" or "auto", empty: split by files
+  std::string jobList;    // fork-server mode: one "outName [entryRange]" per line
+  int nWorkers = 0;       // fork-server mode: 0 means one per CPU core
+  bool isNanoInput = false; // read NanoAOD and apply the Skim selection in memory
+  bool writeCache = false;  // write the binary correction cache of the year/era and exit
+  std::string inJsonDir = jsonDir; // FilesSkim_*.json of the skims to read (TTree or RNTuple)
 
   //--------------------------------
   // Parse command-line options
   //--------------------------------
   int opt;
-  while ((opt = getopt(argc, argv, "o:h")) != -1) {
+  while ((opt = getopt(argc, argv, "o:e:i:j:n:NCh")) != -1) {
     switch (opt) {
       case 'o':
         outName = optarg;
         break;
+      case 'e':
+        entryRange = optarg;
+        break;
+      case 'i':
+        inJsonDir = optarg;
+        if (inJsonDir.back() != '/') inJsonDir += '/';
+        break;
+      case 'j':
+        jobList = optarg;
+        break;
+      case 'n': {
+        std::size_t pos = 0;
+        try {
+          nWorkers = std::stoi(optarg, &pos);
+        } catch (const std::exception&) {
+          pos = 0;
+        }
+        if (pos == 0 || optarg[pos] != '\0' || nWorkers < 0) {
+          std::cerr << "Error: -n expects a number of workers >= 0 (0 = one per CPU core), got \""
+                    << optarg << "\". Use -h for help." << std::endl;
+          return EXIT_FAILURE;
+        }
+        break;
+      }
+      case 'N':
+        isNanoInput = true;
+        break;
+      case 'C':
+        writeCache = true;
+        break;
       case 'h':
         // Loop through each JSON file and print available keys
         for (const auto& jsonFile : jsonFiles) {
@@ -99,6 +296,21 @@ int main(int argc, char* argv[]) {
             std::cout << "./runMain -o " << element.key() << "_Hist_1of100.root" << std::endl;
           }
         }
+        std::cout << "\nOptional: -e start:end  to run global entries [start, end) of the sample\n"
+                  << "          -e auto       to run the NofM balanced shard in entries\n"
+                  << "          (both aligned to TTree clusters, entries cached in config/SkimEntries.json)\n"
+                  << "\nInput lists: -i jsonDir  read FilesSkim_*.json from jsonDir instead of input/json/\n"
+                  << "          (e.g. RNTuple skims written with the Skim option -f rntuple)\n"
+                  << "\nNanoAOD input: -N  read the NanoAOD files of the sample (input/json/FilesNano_*.json)\n"
+                  << "          and apply the Skim filters and triggers in memory, nothing is written in between\n"
+                  << "\nCorrection cache: -o outName -C  parse the correction JSONs of the year/era once and write\n"
+                  << "          cache/Corrections_<year>_<era|MC>.bin; later jobs map it instead of parsing the JSONs\n"
+                  << "\nMulti-sample: -o outName1,outName2,...  (or bare sample keys for the whole sample)\n"
+                  << "          run the samples one after the other, loading the corrections once\n"
+                  << "\nFork-server: -j jobs.txt [-n nWorkers]\n"
+                  << "          load the corrections once and fork one worker per line \"outName [entryRange]\"\n"
+                  << "          of jobs.txt, all lines with the same year, era, channel and data/MC"
+                  << std::endl;
         return 0;
       default:
         std::cerr << "Use -h for help" << std::endl;
@@ -106,43 +318,72 @@ int main(int argc, char* argv[]) {
     }
   }
 
+    std::vector<std::string> jobs;
+    if (!jobList.empty()) {
+        try {
+            jobs = ForkServer::readJobList(jobList);
+        } catch (const std::exception& e) {
+            std::cerr << "Critical error: " << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::istringstream firstJob(jobs.front());
+        firstJob >> outName;
+    }
+    if (outName.empty()) {
+        std::cerr << "Error: provide -o outName or -j jobList. Use -h for help." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Multi-sample mode: -o takes a comma separated list of outNames or bare
+    // sample keys (a bare key runs the whole sample, <key>_Hist_1of1.root)
+    std::vector<std::string> outNames;
+    for (auto& name : Helper::splitString(outName, ",")) {
+        if (name.empty()) continue;
+        if (name.find("_Hist_") == std::string::npos) {
+            name += "_Hist_1of1.root";
+        }
+        outNames.push_back(name);
+    }
+    if (outNames.empty()) {
+        std::cerr << "Error: no outName in -o \"" << outName << "\". Use -h for help." << std::endl;
+        return EXIT_FAILURE;
+    }
+    outName = outNames.front();
+
     Helper::printBanner("Set GlobalFlag.cpp");
     GlobalFlag globalFlag(outName);
     globalFlag.setDebug(false);
     globalFlag.setNDebug(10000);
     globalFlag.printFlags();  
 
-    Helper::printBanner("Set and load SkimFile.cpp");
-    const std::string& inJsonDir = "input/json/";
-    std::shared_ptr<SkimFile> skimF = std::make_shared<SkimFile>(globalFlag, outName, inJsonDir);
-
-    Helper::printBanner("Set and load RunsTree.cpp");
-    std::shared_ptr<RunsTree> runsT = std::make_shared<RunsTree>(globalFlag);
-    Double_t normGenEventSumw = 1.0; 
-    if (globalFlag.isMC()) {
-        std::string cacheFilePath = "config/RunsTree.json";
-        normGenEventSumw = runsT->getCachedNormGenEventSumw(skimF->getSampleKey(), 
-                                                     cacheFilePath, 
-                                                     skimF->getAllFileNames());
+    const auto startupClock = std::chrono::steady_clock::now();
+    // Binary correction cache of this year/era, written with -C
+    const std::string cachePath = CorrectionCache::defaultPath(globalFlag.getYearStr(), globalFlag.getEraStr());
+    std::shared_ptr<const CorrectionCache> correctionCache;
+    if (!writeCache && std::filesystem::exists(cachePath)) {
+        try {
+            correctionCache = CorrectionCache::open(cachePath);
+            if (!correctionCache->isUpToDate()) correctionCache.reset();
+        } catch (const std::exception& e) {
+            std::cerr << "EXCEPTION: " << e.what() << std::endl;
+            correctionCache.reset();
+        }
+        if (!correctionCache) {
+            std::cout << "Ignoring " << cachePath << ", reading the correction JSONs (rebuild it with -C)" << std::endl;
+        }
     }
 
-    Helper::printBanner("Set and load SkimTree.cpp");
-    std::shared_ptr<SkimTree> skimT = std::make_shared<SkimTree>(globalFlag);
-    skimT->loadTree(skimF->getJobFileNames());
-
     Helper::printBanner("Set and load ScaleEvent.cpp");
     // Pass GlobalFlag reference to ScaleEvent
     std::shared_ptr<ScaleEvent> scaleEvent = std::make_shared<ScaleEvent>(globalFlag);
+    if (correctionCache) scaleEvent->setCorrectionCache(correctionCache);
     try {
         scaleEvent->loadJetVetoRef();
         if (globalFlag.isData()) {
             scaleEvent->loadGoldenLumiJson();
             scaleEvent->loadHltLumiJson();
-            scaleEvent->setLumiPerEra(skimF->getXsecOrLumiNano());
         }else{
             scaleEvent->loadPuRef();
-            scaleEvent->setNormGenEventSumw(normGenEventSumw);
-            scaleEvent->setLumiWeightInput(globalFlag.getLumiPerYear(), skimF->getXsecOrLumiNano(), skimF->getEventsNano());
         }
     } catch (const std::runtime_error& e) {
         std::cerr << "Critical error: " << e.what() << std::endl;
@@ -152,6 +393,7 @@ int main(int argc, char* argv[]) {
     Helper::printBanner("Set and load ScaleObject.cpp");
     // Pass GlobalFlag reference to ScaleObject
     std::shared_ptr<ScaleObject> scaleObj = std::make_shared<ScaleObject>(globalFlag);
+    if (correctionCache) scaleObj->setCorrectionCache(correctionCache);
     try {
         scaleObj->loadJetL1FastJetRef();
         scaleObj->loadJetL2RelativeRef();
@@ -173,85 +415,72 @@ int main(int argc, char* argv[]) {
         return EXIT_FAILURE;
     }
 
+    if (writeCache) {
+        Helper::printBanner("Write correction cache");
+        try {
+            CorrectionCacheWriter writer;
+            scaleEvent->writeCorrectionCache(writer);
+            scaleObj->writeCorrectionCache(writer);
+            std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path());
+            writer.write(cachePath);
+        } catch (const std::exception& e) {
+            std::cerr << "Critical error: " << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+        return 0;
+    }
+    // The JERC grids and the veto/pileup tables are built; the raw JSON of
+    // jet_jerc etc. is not needed by the event loop (nor by forked workers)
+    CorrectionRegistry::getInstance().releaseRawJson();
+
     Helper::printBanner("Set and load PickEvent.cpp");
     auto pickEvent = std::make_unique<PickEvent>(globalFlag);
 
     Helper::printBanner("Set and load PickObject.cpp");
     auto pickObject = std::make_unique<PickObject>(globalFlag);
 
-    std::string outDir = "output";
-    mkdir(outDir.c_str(), S_IRWXU);
-    auto fout = std::make_unique<TFile>((outDir + "/" + outName).c_str(), "RECREATE");
+    Helper::printBanner("Startup summary");
+    CorrectionRegistry::getInstance().printStats();
+    std::cout << "Startup time = "
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - startupClock).count()
+              << " s" << std::endl;
 
-    Helper::printBanner("Loop over events and fill Histos");
-
-    
-    if (globalFlag.getChannel() == GlobalFlag::Channel::ZeeJet) {
-        std::cout << "==> Running ZeeJet" << std::endl;
-        auto zeeJet = std::make_unique<RunZeeJet>(globalFlag);
-        zeeJet->Run(skimT, pickEvent.get(), scaleEvent.get(), scaleObj.get(), fout.get());
-    }
-    if (globalFlag.getChannel() == GlobalFlag::Channel::ZmmJet) {
-        std::cout << "==> Running ZmmJet" << std::endl;
-        auto zmmJet = std::make_unique<RunZmmJet>(globalFlag);
-        zmmJet->Run(skimT, pickEvent.get(), scaleEvent.get(), scaleObj.get(), fout.get());
-    }
-
-    if (globalFlag.getChannel() == GlobalFlag::Channel::GamJet) {
-        std::cout << "==> Running GamJet" << std::endl;
-        auto gamJet = std::make_unique<RunGamJet>(globalFlag);
-        gamJet->Run(skimT, pickEvent.get(), scaleEvent.get(), scaleObj.get(), fout.get());
-    }
-    if (globalFlag.getChannel() == GlobalFlag::Channel::GamJetFake) {
-        std::cout << "==> Running GamJetFake" << std::endl;
-        auto gamJetFake = std::make_unique<RunGamJetFake>(globalFlag);
-        gamJetFake->Run(skimT, pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
+    if (jobList.empty() && outNames.size() == 1) {
+        return runJob(globalFlag, outName, entryRange, inJsonDir, isNanoInput, scaleEvent.get(), scaleObj.get(),
+                      pickEvent.get(), pickObject.get());
     }
 
-    if (globalFlag.getChannel() == GlobalFlag::Channel::MultiJet) {
-        std::cout << "==> Running MultiJet" << std::endl;
-        auto multiJet = std::make_unique<RunMultiJet>(globalFlag);
-        multiJet->Run(skimT, pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
-    }
-    if (globalFlag.getChannel() == GlobalFlag::Channel::Wqqe) {
-        std::cout << "==> Running Wqqe" << std::endl;
-        auto wqqe = std::make_unique<RunWqqe>(globalFlag);
-        wqqe->Run(skimT, pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
-    }
-    if (globalFlag.getChannel() == GlobalFlag::Channel::Wqqm) {
-        std::cout << "==> Running Wqqm" << std::endl;
-        auto wqqm = std::make_unique<RunWqqm>(globalFlag);
-        wqqm->Run(skimT, pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
+    if (jobList.empty()) {
+        // One sample after the other, only the sample weights are rebuilt
+        std::vector<std::string> failedNames;
+        for (const auto& name : outNames) {
+            int code = EXIT_FAILURE;
+            try {
+                code = runJob(globalFlag, name, entryRange, inJsonDir, isNanoInput, scaleEvent.get(), scaleObj.get(),
+                              pickEvent.get(), pickObject.get());
+            } catch (const std::exception& e) {
+                std::cerr << "EXCEPTION: " << name << ": " << e.what() << std::endl;
+            }
+            if (code != 0) failedNames.push_back(name);
+        }
+        Helper::printBanner("Processed " + std::to_string(outNames.size()) + " samples");
+        for (const auto& name : failedNames) {
+            std::cerr << "Failed: " << name << std::endl;
+        }
+        return failedNames.empty() ? 0 : EXIT_FAILURE;
     }
-/*
-
-  if (globalFlag->isMCTruth) {
-    std::cout << "==> Running MCTruth" << std::endl;
-    auto mcTruth = std::make_unique<RunMCTruth>(outName);
-    mcTruth->Run(skimT.get(), pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
-  }
-  if (globalFlag->isFlavour) {
-    std::cout << "==> Running Flavour" << std::endl;
-    auto mcFlavour = std::make_unique<RunFlavour>(outName);
-    mcFlavour->Run(skimT.get(), pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
-  }
-  if (globalFlag->isVetoMap) {
-    std::cout << "==> Running VetoMap" << std::endl;
-    auto vetoMap = std::make_unique<RunVetoMap>(outName);
-    vetoMap->Run(skimT.get(), pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
-  }
-  if (globalFlag->isIncJet) {
-    std::cout << "==> Running IncJet" << std::endl;
-    auto incJet = std::make_unique<RunIncJet>(outName);
-    incJet->Run(skimT.get(), pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
-  }
-  if (globalFlag->isDiJet) {
-    std::cout << "==> Running DiJet" << std::endl;
-    auto diJet = std::make_unique<RunDiJet>(outName);
-    diJet->Run(skimT.get(), pickEvent.get(), pickObject.get(), scaleEvent.get(), scaleObj.get(), fout.get());
-  }
-  */
 
-  return 0;
+    Helper::printBanner("Fork one worker per job of " + jobList);
+    std::string outDir = "output";
+    mkdir(outDir.c_str(), S_IRWXU);
+    ForkServer forkServer(nWorkers, outDir);
+    const int nFailed = forkServer.run(jobs, [&](const std::string& job) {
+        std::istringstream iss(job);
+        std::string jobOutName;
+        std::string jobEntryRange;
+        iss >> jobOutName >> jobEntryRange;
+        return runJob(globalFlag, jobOutName, jobEntryRange, inJsonDir, isNanoInput, scaleEvent.get(), scaleObj.get(),
+                      pickEvent.get(), pickObject.get());
+    });
+    return nFailed == 0 ? 0 : EXIT_FAILURE;
 }
-
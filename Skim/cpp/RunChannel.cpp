@@ -14,10 +14,17 @@ void RunChannel::runEventLoop(NanoTree* nanoT, TFile* fout) {
     Long64_t nentries = nanoT->getEntries();
     std::cout << "\nSample has " << nentries << " entries\n";
 
-    // Clone the tree and set cache.
-    TTree* newTree = nanoT->fChain->GetTree()->CloneTree(0);
-    newTree->SetDirectory(fout);  // Ensure newTree is owned by fout.
-    newTree->SetCacheSize(Helper::tTreeCatchSize);
+    // Clone the tree and set cache, or map the enabled branches onto RNTuple fields.
+    TTree* newTree = nullptr;
+    std::unique_ptr<SkimNTupleWriter> ntupleWriter;
+    if (isRNTupleOutput_) {
+        ntupleWriter = std::make_unique<SkimNTupleWriter>(nanoT->fChain, fout,
+            std::vector<std::map<std::string, Bool_t>*>{&filterVals_, &trigVals_});
+    } else {
+        newTree = nanoT->fChain->GetTree()->CloneTree(0);
+        newTree->SetDirectory(fout);  // Ensure newTree is owned by fout.
+        newTree->SetCacheSize(Helper::tTreeCatchSize);
+    }
 
     // Setup cutflow histogram using newTree's file directory.
     std::vector<std::string> cuts = { "NanoAOD", "Filter", "Trigger" };
@@ -51,18 +58,25 @@ void RunChannel::runEventLoop(NanoTree* nanoT, TFile* fout) {
             if (!trigTBranches_[trig]) continue;
             trigTBranches_[trig]->GetEntry(entry);
             if (trigVals_[trig]) {
+                if (ntupleWriter) ntupleWriter->prepare(entry);
                 nanoT->fChain->GetTree()->GetEntry(entry);
                 h1EventInCutflow->fill("Trigger");
-                newTree->Fill();
+                if (ntupleWriter) ntupleWriter->fill();
+                else newTree->Fill();
                 break;
             }
         }
     }
     Helper::printCutflow(h1EventInCutflow->getHistogram());
-    std::cout << "nEvents_Skim = " << newTree->GetEntries() << "\n";
     fout->cd();
     h1EventInCutflow->Write();
-    newTree->Write("", TObject::kOverwrite);
+    if (ntupleWriter) {
+        std::cout << "nEvents_Skim = " << ntupleWriter->getEntries() << " (RNTuple)\n";
+        ntupleWriter->commit();
+    } else {
+        std::cout << "nEvents_Skim = " << newTree->GetEntries() << "\n";
+        newTree->Write("", TObject::kOverwrite);
+    }
 
     std::cout << "\nNow process the RunsTree \n";
     // Force loading the first tree in the chain.
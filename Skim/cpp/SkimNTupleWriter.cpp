@@ -0,0 +1,241 @@
+#include "SkimNTupleWriter.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <functional>
+#include <algorithm>
+
+#include <TBranch.h>
+#include <TLeaf.h>
+#include <TObjArray.h>
+
+#ifdef USE_RNTUPLE
+#include <ROOT/RNTupleModel.hxx>
+#include <ROOT/RNTupleWriter.hxx>
+
+namespace rnt = ROOT::Experimental;
+
+namespace {
+
+// Initial read buffer of a counted array. NanoAOD collections are far below
+// this; prepare() grows the buffer for an entry that has more elements.
+constexpr Int_t kMinArrayCapacity = 4096;
+
+struct Column {
+    virtual ~Column() = default;
+    virtual void fill() = 0;
+    virtual void reserve(TChain*) {}
+};
+
+template <typename T>
+struct ScalarColumn : Column {
+    T buffer{};
+    const T* source = &buffer; // Points to an external buffer for already-bound branches
+    std::shared_ptr<T> field;
+    void fill() override { *field = *source; }
+};
+
+template <typename T>
+struct ArrayColumn : Column {
+    std::unique_ptr<T[]> buffer;
+    std::size_t capacity = 0;
+    std::string name;
+    std::function<std::size_t()> count;
+    std::shared_ptr<std::vector<T>> field;
+    // Called once the count of the entry is read and before the array itself is
+    void reserve(TChain* chain) override {
+        const std::size_t n = count();
+        if (n <= capacity) return;
+        capacity = std::max(n, 2 * capacity);
+        buffer = std::make_unique<T[]>(capacity);
+        chain->SetBranchAddress(name.c_str(), buffer.get());
+    }
+    void fill() override {
+        const std::size_t n = count();
+        if (n > capacity) {
+            throw std::runtime_error("SkimNTupleWriter: " + name + " has " + std::to_string(n) +
+                                     " elements, buffer holds " + std::to_string(capacity));
+        }
+        field->assign(buffer.get(), buffer.get() + n);
+    }
+};
+
+using Columns = std::vector<std::unique_ptr<Column>>;
+using Counts = std::map<std::string, std::function<std::size_t()>>;
+
+template <typename T>
+void addScalar(TChain* chain, rnt::RNTupleModel& model, Columns& columns, Counts& counts,
+               const std::string& name, const Bool_t* external) {
+    auto col = std::make_unique<ScalarColumn<T>>();
+    if constexpr (std::is_same_v<T, Bool_t>) {
+        if (external) col->source = external;
+    }
+    if (col->source == &col->buffer) {
+        chain->SetBranchAddress(name.c_str(), &col->buffer);
+    }
+    col->field = model.MakeField<T>(name);
+    const T* source = col->source;
+    counts[name] = [source]() { return static_cast<std::size_t>(*source); };
+    columns.push_back(std::move(col));
+}
+
+template <typename T>
+void addArray(TChain* chain, rnt::RNTupleModel& model, Columns& columns,
+              const std::string& name, std::size_t capacity, std::function<std::size_t()> count) {
+    auto col = std::make_unique<ArrayColumn<T>>();
+    col->buffer = std::make_unique<T[]>(capacity);
+    col->capacity = capacity;
+    col->name = name;
+    col->count = std::move(count);
+    chain->SetBranchAddress(name.c_str(), col->buffer.get());
+    col->field = model.MakeField<std::vector<T>>(name);
+    columns.push_back(std::move(col));
+}
+
+// Dispatch on the leaf type name; returns false for unsupported types.
+template <template <typename> class Tag, typename Fn>
+bool dispatchType(const std::string& typeName, Fn&& fn) {
+    if (typeName == "Float_t")   { fn(Tag<Float_t>{});   return true; }
+    if (typeName == "Double_t")  { fn(Tag<Double_t>{});  return true; }
+    if (typeName == "Int_t")     { fn(Tag<Int_t>{});     return true; }
+    if (typeName == "UInt_t")    { fn(Tag<UInt_t>{});    return true; }
+    if (typeName == "Short_t")   { fn(Tag<Short_t>{});   return true; }
+    if (typeName == "UShort_t")  { fn(Tag<UShort_t>{});  return true; }
+    if (typeName == "Char_t")    { fn(Tag<Char_t>{});    return true; }
+    if (typeName == "UChar_t")   { fn(Tag<UChar_t>{});   return true; }
+    if (typeName == "Bool_t")    { fn(Tag<Bool_t>{});    return true; }
+    if (typeName == "Long64_t")  { fn(Tag<Long64_t>{});  return true; }
+    if (typeName == "ULong64_t") { fn(Tag<ULong64_t>{}); return true; }
+    return false;
+}
+
+template <typename T>
+struct TypeTag { using type = T; };
+
+} // namespace
+
+struct SkimNTupleWriter::Impl {
+    TChain* chain = nullptr;
+    Columns columns;
+    Counts counts;
+    std::vector<std::string> countNames; // Count leaves of the counted arrays
+    std::unique_ptr<rnt::RNTupleWriter> writer;
+};
+
+SkimNTupleWriter::SkimNTupleWriter(TChain* chain, TFile* fout,
+                                   const std::vector<std::map<std::string, Bool_t>*>& boundFlags)
+    : impl_(std::make_unique<Impl>()) {
+    impl_->chain = chain;
+    if (chain->LoadTree(0) < 0 || !chain->GetTree()) {
+        throw std::runtime_error("SkimNTupleWriter: cannot load the first tree of the chain");
+    }
+    std::map<std::string, const Bool_t*> external;
+    for (auto* flags : boundFlags) {
+        for (auto& [name, value] : *flags) external[name] = &value;
+    }
+
+    auto model = rnt::RNTupleModel::Create();
+    TObjArray* branches = chain->GetTree()->GetListOfBranches();
+
+    // Pass 1: scalars (this includes the count leaves of the arrays)
+    std::vector<TLeaf*> arrayLeaves;
+    for (int i = 0; i < branches->GetEntries(); ++i) {
+        auto* br = static_cast<TBranch*>(branches->At(i));
+        const std::string name = br->GetName();
+        if (!chain->GetBranchStatus(name.c_str())) continue;
+        auto* leaf = static_cast<TLeaf*>(br->GetListOfLeaves()->At(0));
+        if (!leaf) continue;
+        if (leaf->GetLeafCount() || leaf->GetLenStatic() > 1) {
+            arrayLeaves.push_back(leaf);
+            continue;
+        }
+        auto it = external.find(name);
+        const Bool_t* ext = (it != external.end()) ? it->second : nullptr;
+        bool ok = dispatchType<TypeTag>(leaf->GetTypeName(), [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            addScalar<T>(chain, *model, impl_->columns, impl_->counts, name, ext);
+        });
+        if (!ok) std::cerr << "Warning: SkimNTupleWriter skips " << name
+                           << " of unsupported type " << leaf->GetTypeName() << '\n';
+    }
+
+    // Pass 2: arrays, sized by their count leaf (enabled on demand) or a fixed length
+    for (TLeaf* leaf : arrayLeaves) {
+        const std::string name = leaf->GetBranch()->GetName();
+        std::function<std::size_t()> count;
+        Int_t capacity = leaf->GetLenStatic();
+        if (TLeaf* leafCount = leaf->GetLeafCount()) {
+            const std::string countName = leafCount->GetBranch()->GetName();
+            if (impl_->counts.find(countName) == impl_->counts.end()) {
+                chain->SetBranchStatus(countName.c_str(), true);
+                dispatchType<TypeTag>(leafCount->GetTypeName(), [&](auto tag) {
+                    using T = typename decltype(tag)::type;
+                    addScalar<T>(chain, *model, impl_->columns, impl_->counts, countName, nullptr);
+                });
+            }
+            if (std::find(impl_->countNames.begin(), impl_->countNames.end(), countName) ==
+                impl_->countNames.end()) {
+                impl_->countNames.push_back(countName);
+            }
+            const std::size_t perCount = capacity;
+            auto countOf = impl_->counts.at(countName);
+            count = [countOf, perCount]() { return perCount * countOf(); };
+            capacity *= std::max(kMinArrayCapacity, 2 * leafCount->GetMaximum());
+        } else {
+            const std::size_t fixed = capacity;
+            count = [fixed]() { return fixed; };
+        }
+        bool ok = dispatchType<TypeTag>(leaf->GetTypeName(), [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            addArray<T>(chain, *model, impl_->columns, name, capacity, count);
+        });
+        if (!ok) std::cerr << "Warning: SkimNTupleWriter skips " << name
+                           << " of unsupported type " << leaf->GetTypeName() << '\n';
+    }
+
+    std::cout << "SkimNTupleWriter: " << impl_->columns.size() << " fields in RNTuple 'Events'\n";
+    impl_->writer = rnt::RNTupleWriter::Append(std::move(model), "Events", *fout);
+}
+
+void SkimNTupleWriter::prepare(Long64_t entry) {
+    TTree* tree = impl_->chain->GetTree();
+    for (const auto& countName : impl_->countNames) {
+        if (TBranch* br = tree->GetBranch(countName.c_str())) br->GetEntry(entry);
+    }
+    for (auto& col : impl_->columns) col->reserve(impl_->chain);
+}
+
+void SkimNTupleWriter::fill() {
+    for (auto& col : impl_->columns) col->fill();
+    impl_->writer->Fill();
+    ++nFilled_;
+}
+
+void SkimNTupleWriter::commit() {
+    // The writer commits the last cluster and the anchor on destruction.
+    impl_->writer.reset();
+}
+
+bool SkimNTupleWriter::isAvailable() { return true; }
+
+#else
+
+struct SkimNTupleWriter::Impl {};
+
+SkimNTupleWriter::SkimNTupleWriter(TChain*, TFile*, const std::vector<std::map<std::string, Bool_t>*>&) {
+    throw std::runtime_error("SkimNTupleWriter: RNTuple output needs a build with 'make RNTUPLE=1'");
+}
+
+void SkimNTupleWriter::prepare(Long64_t) {}
+
+void SkimNTupleWriter::fill() {}
+
+void SkimNTupleWriter::commit() {}
+
+bool SkimNTupleWriter::isAvailable() { return false; }
+
+#endif
+
+SkimNTupleWriter::~SkimNTupleWriter() {
+    if (impl_) commit();
+}
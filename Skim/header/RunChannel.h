@@ -15,6 +15,7 @@
 #include "HistCutflow.h"
 #include "Helper.h"
 #include "ReadConfig.h" // Include the new ReadConfig
+#include "SkimNTupleWriter.h"
 
 class RunChannel {
 public:
@@ -24,6 +25,9 @@ public:
     // Implements the full processing; derived classes only need to provide configuration details.
     virtual int Run(std::shared_ptr<NanoTree>& nanoT, ReadConfig &readConfig, TFile* fout);
 
+    // Write the Events as RNTuple instead of TTree (Runs stays a TTree)
+    void setRNTupleOutput(bool isRNTuple) { isRNTupleOutput_ = isRNTuple; }
+
 protected:
     GlobalFlag& globalFlags_;
     std::vector<std::string> filterList_;
@@ -34,6 +38,8 @@ protected:
     std::map<std::string, Bool_t> trigVals_;
     std::map<std::string, TBranch*> trigTBranches_;
 
+    bool isRNTupleOutput_ = false;
+
     // Event loop
     void runEventLoop(NanoTree* nanoT, TFile* fout);
 
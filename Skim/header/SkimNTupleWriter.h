@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <TChain.h>
+#include <TFile.h>
+
+/*
+ * Writes the skimmed events as an RNTuple named "Events" instead of a cloned TTree.
+ *
+ * Every branch that is enabled on the NanoAOD chain becomes one field:
+ *   - scalar leaves (e.g. run, nJet)    -> field of the same type
+ *   - counted arrays (e.g. Jet_pt)      -> std::vector<T>, sized by the count leaf
+ * Branches that RunChannel already bound for the filter/trigger decision are
+ * reused as-is, so no branch gets two addresses.
+ *
+ * Requires ROOT >= 6.30 and a build with RNTUPLE=1 (defines USE_RNTUPLE).
+ */
+class SkimNTupleWriter {
+public:
+    SkimNTupleWriter(TChain* chain, TFile* fout,
+                     const std::vector<std::map<std::string, Bool_t>*>& boundFlags);
+    ~SkimNTupleWriter();
+
+    // Read the count leaves of a local tree entry and grow the array buffers
+    // if needed; call before GetEntry of that entry
+    void prepare(Long64_t entry);
+
+    // Copy the current chain entry (already read with GetEntry) into the RNTuple
+    void fill();
+
+    Long64_t getEntries() const { return nFilled_; }
+
+    // Flush the last cluster and write the anchor; called by the destructor if needed
+    void commit();
+
+    static bool isAvailable();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+    Long64_t nFilled_ = 0;
+};
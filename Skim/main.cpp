@@ -41,16 +41,24 @@ int main(int argc, char* argv[]){
     
     nlohmann::json js;
     std::string outName;
+    std::string outFormat = "ttree";
     
     //--------------------------------
     // Parse command-line options
     //--------------------------------
     int opt;
-    while ((opt = getopt(argc, argv, "o:h")) != -1) {
+    while ((opt = getopt(argc, argv, "o:f:h")) != -1) {
       switch (opt) {
         case 'o':
           outName = optarg;
           break;
+        case 'f':
+          outFormat = optarg;
+          if (outFormat != "ttree" && outFormat != "rntuple") {
+            std::cerr << "Error: -f must be 'ttree' or 'rntuple'" << std::endl;
+            return 1;
+          }
+          break;
         case 'h':
           // Loop through each JSON file and print available keys
           for (const auto& jsonFile : jsonFiles) {
@@ -73,6 +81,7 @@ int main(int argc, char* argv[]){
               std::cout <<"./runMain -o "<<element.key()<<"_Skim_1of100.root" << std::endl;
             }
           }
+          std::cout << "\nOptional: -f rntuple to write the Events as RNTuple (build with make RNTUPLE=1)" << std::endl;
           return 0;
         default:
           std::cerr << "Use -h for help" << std::endl;
@@ -107,6 +116,7 @@ int main(int argc, char* argv[]){
     Helper::printBanner("Finally RunChannel.cpp");
     std::cout << "==> Running for: " << channelConfigPath << std::endl;
     auto runCh = std::make_unique<RunChannel>(globalFlag);
+    runCh->setRNTupleOutput(outFormat == "rntuple");
     runCh->Run(nanoT, readConfig, fout.get());
 
 	return 0;